@@ -0,0 +1,146 @@
+/*
+ * Coalesces ILC unicast set commands into broadcast.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ILC_BroadcastCoalescer__
+#define __ILC_BroadcastCoalescer__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <ILC/ILCBusList.h>
+#include <Modbus/Frame.h>
+
+namespace ILC {
+
+/**
+ * Collects values of a set function (e.g. thermal demand or stepper steps)
+ * commanded to @glos{ILC}s during a cycle. When the cycle is flushed into a
+ * bus list, values are send either in a single broadcast frame, or as
+ * unicast commands.
+ *
+ * Broadcast payload contains values for all @glos{ILC}s, ordered as
+ * addresses passed to the constructor. As broadcast changes all
+ * @glos{ILC}s, last commanded values are kept and send for @glos{ILC}s not
+ * commanded in the cycle. Broadcast is used only if values for all
+ * @glos{ILC}s are known and at least threshold @glos{ILC}s were commanded
+ * in the cycle. Otherwise unicast commands are added for commanded
+ * @glos{ILC}s.
+ *
+ * @code{.cpp}
+ * ILC::BroadcastCoalescer demand(88, 500, 250, 450, addresses, 2);
+ * for (auto address : addresses) {
+ *     demand.set(address, heater[address], fan[address]);
+ * }
+ * demand.flush(busList);
+ * @endcode
+ */
+class BroadcastCoalescer {
+public:
+    /**
+     * Constructs coalescer.
+     *
+     * @param func function code, the same for unicast and broadcast
+     * @param timing unicast command timing in microseconds
+     * @param broadcastAddress broadcast address
+     * @param broadcastDelay delay after broadcast in microseconds
+     * @param addresses @glos{ILC} addresses, in broadcast payload order
+     * @param payloadSize number of bytes commanded for a single @glos{ILC}
+     * @param threshold minimal number of @glos{ILC}s commanded in cycle to
+     * use broadcast
+     */
+    BroadcastCoalescer(uint8_t func, uint32_t timing, uint8_t broadcastAddress, uint32_t broadcastDelay,
+                       const std::vector<uint8_t> &addresses, size_t payloadSize, size_t threshold = 2);
+
+    /**
+     * Sets value commanded to an @glos{ILC}. Values are encoded as in
+     * unicast function call.
+     *
+     * @param address @glos{ILC} address
+     * @param values commanded values
+     *
+     * @throw std::out_of_range if address isn't handled by the coalescer
+     * @throw std::runtime_error if values size doesn't match payload size
+     */
+    template <typename... dt>
+    void set(uint8_t address, const dt &...values) {
+        Modbus::Frame frame;
+        (frame.write(values), ...);
+        setPayload(address, frame.data(), frame.size());
+    }
+
+    /**
+     * Sets encoded value commanded to an @glos{ILC}.
+     *
+     * @param address @glos{ILC} address
+     * @param payload encoded values
+     * @param length payload length
+     *
+     * @throw std::out_of_range if address isn't handled by the coalescer
+     * @throw std::runtime_error if length doesn't match payload size
+     */
+    void setPayload(uint8_t address, const uint8_t *payload, size_t length);
+
+    /**
+     * Adds commands for the values set since the last flush to the bus list.
+     *
+     * @param busList bus list to add commands to
+     *
+     * @return true if broadcast was added, false if unicast commands (or
+     * nothing) were added
+     */
+    bool flush(ILCBusList &busList);
+
+    /**
+     * Returns number of @glos{ILC}s commanded since the last flush.
+     *
+     * @return number of pending @glos{ILC} commands
+     */
+    size_t pending() const { return _pendingCount; }
+
+    /**
+     * Forgets all commanded values.
+     */
+    void clear();
+
+private:
+    uint8_t _func;
+    uint32_t _timing;
+    uint8_t _broadcastAddress;
+    uint32_t _broadcastDelay;
+    std::vector<uint8_t> _addresses;
+    size_t _payloadSize;
+    size_t _threshold;
+
+    std::array<int16_t, 256> _slots;
+    std::vector<uint8_t> _payload;
+    std::vector<uint8_t> _unicast;
+    std::vector<bool> _known;
+    std::vector<bool> _pending;
+    size_t _knownCount;
+    size_t _pendingCount;
+};
+
+}  // namespace ILC
+
+#endif /* !__ILC_BroadcastCoalescer__ */
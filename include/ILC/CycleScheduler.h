@@ -0,0 +1,181 @@
+/*
+ * Fills ILC bus list with commands fitting into a cycle.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ILC_CycleScheduler__
+#define __ILC_CycleScheduler__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <ILC/ILCBusList.h>
+
+namespace ILC {
+
+/**
+ * Priority of scheduled commands.
+ */
+enum class Priority {
+    CRITICAL,   ///< always send
+    PERIODIC,   ///< send if fits into cycle, before background commands
+    BACKGROUND  ///< send if fits into cycle
+};
+
+/**
+ * Schedules @glos{ILC} commands into cycles of given time budget. Each cycle
+ * all critical commands are added to the bus list. The remaining time is
+ * filled with periodic and then background commands, taken in round-robin
+ * order - the next cycle continues with the first command which didn't fit.
+ *
+ * Command time is estimated from transmitted bytes (at the bus baud rate)
+ * and command timing, rounded as it is encoded in @glos{FPGA} wait for reply
+ * word. Periodic and background commands are sized from frames declared when
+ * the command is added, so commands which don't fit aren't run. If the
+ * command adds longer frames, time measured in the last cycle the command
+ * was sent in is used. Commands adding no frames (e.g. skipped by
+ * BusList::suppressUnchanged) keep the declared time. Periodic and
+ * background commands taking longer than the budget are never sent - a
+ * warning is logged.
+ *
+ * @code{.cpp}
+ * ILC::CycleScheduler scheduler(5000, 1000000);
+ * scheduler.add(ILC::Priority::CRITICAL, [](ILC::ILCBusList &bl) { bl.reportServerStatus(18); });
+ * scheduler.add(ILC::Priority::BACKGROUND, [](ILC::ILCBusList &bl) { bl.reportServerID(18); }, {{4, 835}});
+ *
+ * scheduler.fill(busList);
+ * fpga.ilcCommands(busList, 200);
+ * @endcode
+ */
+class CycleScheduler {
+public:
+    typedef std::function<void(ILCBusList &)> Command;
+
+    /**
+     * Frame added by a scheduled command.
+     */
+    struct FrameModel {
+        size_t length;    ///< request length in bytes, including address, function code and CRC
+        uint32_t timing;  ///< command timing in microseconds, as passed to callFunction
+    };
+
+    /**
+     * Constructs scheduler.
+     *
+     * @param budget cycle time budget in microseconds
+     * @param baudRate bus baud rate
+     * @param bitsPerByte bits transmitted per byte (including start, parity
+     * and stop bits)
+     */
+    CycleScheduler(uint32_t budget, uint32_t baudRate, uint32_t bitsPerByte = 10);
+
+    /**
+     * Adds command to the scheduler.
+     *
+     * @param priority command priority
+     * @param command action adding command(s) to the bus list
+     * @param frames frames added by the command. Required for periodic and
+     * background commands, which are sized before they are run
+     *
+     * @throw std::invalid_argument if frames of periodic or background
+     * command aren't specified
+     */
+    void add(Priority priority, Command command, const std::vector<FrameModel> &frames = {});
+
+    /**
+     * Removes all scheduled commands.
+     */
+    void clear();
+
+    /**
+     * Clears bus list and fills it with commands for the next cycle.
+     *
+     * @param busList bus list to fill. Cannot be frozen
+     *
+     * @return estimated cycle time in microseconds. Can exceed the budget if
+     * critical commands don't fit
+     */
+    uint32_t fill(ILCBusList &busList);
+
+    /**
+     * Returns estimated time of command transmission and reply.
+     *
+     * @param record command record
+     *
+     * @return estimated time in microseconds
+     */
+    uint32_t commandTime(const Modbus::CommandRecord &record) const {
+        return commandTime(record.buffer.size(), record.timing);
+    }
+
+    /**
+     * Returns estimated time of command transmission and reply.
+     *
+     * @param length request length in bytes
+     * @param timing command timing in microseconds
+     *
+     * @return estimated time in microseconds
+     */
+    uint32_t commandTime(size_t length, uint32_t timing) const;
+
+    /**
+     * Returns cycle time budget.
+     *
+     * @return budget in microseconds
+     */
+    uint32_t getBudget() const { return _budget; }
+
+    /**
+     * Sets cycle time budget.
+     *
+     * @param budget new budget in microseconds
+     */
+    void setBudget(uint32_t budget);
+
+private:
+    struct Entry {
+        Command command;
+        uint32_t declared = 0;  ///< time of the declared frames
+        uint32_t time = 0;      ///< estimated time, never less than declared
+        bool reported = false;
+    };
+
+    struct Queue {
+        std::vector<Entry> entries;
+        int32_t next = 0;
+    };
+
+    uint32_t _budget;
+    uint32_t _baudRate;
+    uint32_t _bitsPerByte;
+
+    std::vector<Entry> _critical;
+    Queue _periodic;
+    Queue _background;
+
+    bool _emit(Entry &entry, ILCBusList &busList, uint32_t &used, bool force);
+    void _fillQueue(Queue &queue, ILCBusList &busList, uint32_t &used);
+};
+
+}  // namespace ILC
+
+#endif /* !__ILC_CycleScheduler__ */
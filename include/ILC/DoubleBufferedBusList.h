@@ -0,0 +1,90 @@
+/*
+ * Double buffered ILC bus list.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ILC_DoubleBufferedBusList__
+#define __ILC_DoubleBufferedBusList__
+
+#include <ILC/ILCBusList.h>
+
+namespace ILC {
+
+/**
+ * Holds two bus lists of the same type. While the front list is in flight
+ * (submitted with LSST::cRIO::FPGA::ilcSubmit), commands for the next cycle
+ * are added to the back list. Once the front list is collected, lists are
+ * swapped.
+ *
+ * Both lists are constructed with the same arguments. As each list has its
+ * own response callbacks and members, data received by the callbacks shall
+ * be stored outside of the lists.
+ *
+ * @tparam T ILCBusList subclass
+ */
+template <class T>
+class DoubleBufferedBusList {
+public:
+    /**
+     * Construct both lists.
+     *
+     * @param args arguments passed to both lists constructors
+     */
+    template <typename... Args>
+    DoubleBufferedBusList(const Args &...args) : _first(args...), _second(args...), _front(&_first) {}
+
+    DoubleBufferedBusList(const DoubleBufferedBusList &) = delete;
+    DoubleBufferedBusList &operator=(const DoubleBufferedBusList &) = delete;
+
+    /**
+     * Returns list to submit (or already submitted).
+     *
+     * @return list in flight
+     */
+    T &front() { return *_front; }
+
+    /**
+     * Returns list to fill with the next cycle commands.
+     *
+     * @return list to prepare
+     */
+    T &back() { return _front == &_first ? _second : _first; }
+
+    /**
+     * Swap front and back lists. The former front list is cleared - unless
+     * it is frozen - so it's ready to accept next cycle commands.
+     */
+    void swap() {
+        if (front().frozen() == false) {
+            front().clear();
+        }
+        _front = &back();
+    }
+
+private:
+    // lists cannot be copied, as response callbacks capture this
+    T _first;
+    T _second;
+    T *_front;
+};
+
+}  // namespace ILC
+
+#endif  // !__ILC_DoubleBufferedBusList__
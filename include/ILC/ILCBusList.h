@@ -23,9 +23,12 @@
 #ifndef __ILC_BusList__
 #define __ILC_BusList__
 
+#include <atomic>
+#include <map>
 #include <string>
 
 #include <Modbus/BusList.h>
+#include <Modbus/Reply.h>
 
 namespace ILC {
 
@@ -48,6 +51,8 @@ enum Fault {
     AUX = 0x2000
 };
 
+class BroadcastCoalescer;
+
 /**
  * Handles basic @glos{ILC} communication. Provides methods to run @glos{ILC}
  * functions and callback for responses.
@@ -78,6 +83,44 @@ public:
      */
     const uint8_t getBus() { return _bus; }
 
+    /**
+     * Returns true for @glos{ILC} broadcast addresses - 0, 148, 149, 248, 250
+     * and 255.
+     *
+     * @param address @glos{ILC} address
+     *
+     * @return true if the address is broadcast address
+     */
+    bool isBroadcast(uint8_t address) override {
+        return address == 0 || address == 148 || address == 149 || address == 248 || address == 250 ||
+               address == 255;
+    }
+
+    /**
+     * Returns expected reply length. Uses reply lengths registered with
+     * addResponseLength and setResponseLength. Error replies are 5 bytes
+     * long (address, function, error code and CRC).
+     *
+     * @param response reply received so far
+     *
+     * @return total reply length, -1 if it isn't known (yet)
+     */
+    int responseLength(const std::vector<uint8_t> &response) override;
+
+    /**
+     * Sets reply length of the function for a single @glos{ILC}. Shall be
+     * used for replies which length depends on the @glos{ILC} type and cannot
+     * be determined from the reply (e.g. number of load cells or sensors).
+     * Takes precedence over length registered with addResponseLength.
+     *
+     * @param address @glos{ILC} address
+     * @param func function code
+     * @param length total reply length, including address, function and CRC
+     */
+    void setResponseLength(uint8_t address, uint8_t func, uint16_t length) {
+        _addressResponseLengths[_key(address, func)] = length;
+    }
+
     /**
      * Calls function 17 (0x11), ask for @glos{ILC} identity.
      *
@@ -125,9 +168,12 @@ public:
     }
 
     /**
-     * Reset ILC. Calls function 107 (0x6b).
+     * Reset ILC. Calls function 107 (0x6b). Acknowledged arguments cached for
+     * the @glos{ILC} are forgotten when reset is replied.
      *
      * @param address @glos{ICL} address
+     *
+     * @see Modbus::BusList::suppressUnchanged
      */
     void resetServer(uint8_t address) { callFunction(address, ILC_CMD::RESET_SERVER, 86840); }
 
@@ -143,6 +189,41 @@ public:
     };
 
 protected:
+    friend class BroadcastCoalescer;
+
+    /**
+     * Registers reply length of the function. Used by responseLength to
+     * determine when the reply was fully received.
+     *
+     * @param func function code
+     * @param length total reply length (including address, function and
+     * CRC), or length of the fixed part of the reply if lengthIndex is
+     * specified
+     * @param lengthIndex index of the reply byte holding number of the
+     * variable length data bytes. 0 for fixed length replies
+     */
+    void addResponseLength(uint8_t func, uint8_t length, uint8_t lengthIndex = 0) {
+        _responseLengths.set(func, ResponseLength{length, lengthIndex});
+    }
+
+    /**
+     * Registers response action and reply length of fixed length reply.
+     *
+     * @tparam reply Modbus::Reply describing the reply values
+     *
+     * @param func function code
+     * @param callback callback called with @glos{ILC} address and decoded
+     * reply values
+     * @param error_action action called on error response
+     *
+     * @see Modbus::Reply
+     */
+    template <typename reply, typename Callback>
+    void addReply(uint8_t func, Callback callback, std::function<void(uint8_t, uint8_t)> error_action = nullptr) {
+        add_response(func, reply::action(callback), error_action);
+        addResponseLength(func, reply::LENGTH);
+    }
+
     /**
      * Call broadcast function.
      *
@@ -170,7 +251,7 @@ protected:
      */
     template <typename data_type>
     void broadcastFunction(uint8_t address, uint8_t func, uint32_t delay, uint8_t counter,
-                           std::vector<data_type> data = {}) {
+                           const data_type &data) {
         callFunction(address, func, delay, counter, data);
     }
 
@@ -215,7 +296,9 @@ protected:
      *
      * @throw std::out_of_range when @glos{ILC} mode is not known
      */
-    uint8_t getLastMode(uint8_t address) { return _lastMode.at(address); }
+    uint8_t getLastMode(uint8_t address) const {
+        return _lastMode.at(address).load(std::memory_order_relaxed);
+    }
 
     /**
      * Return @glos{ILC} fault textual description.
@@ -340,8 +423,18 @@ protected:
 private:
     const int _bus;
 
-    std::map<uint8_t, uint8_t> _lastMode;  ///< last know @glos{ILC} mode
+    Modbus::ByteMap<std::atomic<uint8_t>> _lastMode;  ///< last know @glos{ILC} mode
     uint8_t _broadcastCounter = 0;
+
+    struct ResponseLength {
+        uint8_t length;
+        uint8_t lengthIndex;
+    };
+
+    Modbus::ByteMap<ResponseLength> _responseLengths;
+    std::map<uint16_t, uint16_t> _addressResponseLengths;
+
+    static uint16_t _key(uint8_t address, uint8_t func) { return (static_cast<uint16_t>(address) << 8) | func; }
 };
 
 }  // namespace ILC
@@ -44,6 +44,17 @@ public:
      */
     void reportSensorValues(uint8_t address) { callFunction(address, SENSOR_VALUES, 400); }
 
+    /**
+     * Sets number of sensors reported by the @glos{ILC}. Used to calculate
+     * expected length of function 84 reply.
+     *
+     * @param address @glos{ILC} address
+     * @param count number of reported sensor values
+     *
+     * @throw std::out_of_range if the reply would be longer than Modbus frame
+     */
+    void setSensorCount(uint8_t address, uint8_t count);
+
     enum SENSOR_MONITOR_CMD { SENSOR_VALUES = 84 };
 
 protected:
@@ -0,0 +1,139 @@
+/*
+ * Adaptive Modbus reply timing.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Modbus_AdaptiveTiming__
+#define __Modbus_AdaptiveTiming__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <Modbus/ByteMap.h>
+
+namespace Modbus {
+
+/**
+ * Learns reply latencies of Modbus functions. Keeps histogram of observed
+ * latencies for each address and function pair. Once enough replies were
+ * observed, provides timing equal to 99.9th percentile of the latencies plus
+ * a margin, never exceeding the ceiling (worst case timing hard-coded in the
+ * function call). Missing reply resets the pair history, so the ceiling is
+ * used until enough replies are observed again.
+ *
+ * Histogram counts are halved when the number of samples reaches the limit,
+ * so older replies are gradually forgotten. Histograms are found through flat
+ * per function and address tables, allocated when a function or address
+ * reply is recorded for the first time.
+ */
+class AdaptiveTiming {
+public:
+    /**
+     * Constructs adaptive timing.
+     *
+     * @param margin margin added to the observed latency, in microseconds
+     * @param minSamples number of replies needed before timing is adapted
+     */
+    AdaptiveTiming(uint32_t margin = 50, uint32_t minSamples = 100);
+
+    /**
+     * Copies recorded latencies.
+     *
+     * @param other adaptive timing to copy
+     */
+    AdaptiveTiming(const AdaptiveTiming &other);
+    AdaptiveTiming(AdaptiveTiming &&other) = default;
+
+    AdaptiveTiming &operator=(const AdaptiveTiming &other);
+    AdaptiveTiming &operator=(AdaptiveTiming &&other) = default;
+
+    /**
+     * Records observed reply latency.
+     *
+     * @param address Modbus address
+     * @param func Modbus function
+     * @param latency reply latency in microseconds
+     */
+    void record(uint8_t address, uint8_t func, uint32_t latency);
+
+    /**
+     * Records missing reply. Forgets history of the address and function.
+     *
+     * @param address Modbus address
+     * @param func Modbus function
+     */
+    void miss(uint8_t address, uint8_t func);
+
+    /**
+     * Returns timing for the function call.
+     *
+     * @param address Modbus address
+     * @param func Modbus function
+     * @param ceiling maximal (worst case) timing in microseconds
+     *
+     * @return timing in microseconds, less or equal to ceiling
+     */
+    uint32_t timing(uint8_t address, uint8_t func, uint32_t ceiling);
+
+    /**
+     * Forgets all recorded latencies.
+     */
+    void clear();
+
+    /**
+     * Width of histogram bin, in microseconds.
+     */
+    static constexpr uint32_t BIN_WIDTH = 16;
+
+    /**
+     * Number of histogram bins. Latencies above the last bin are counted in
+     * overflow bin, and result in ceiling timing.
+     */
+    static constexpr size_t BINS = 256;
+
+    /**
+     * Number of samples when histogram counts are halved.
+     */
+    static constexpr uint32_t DECAY_LIMIT = 8192;
+
+private:
+    struct Histogram {
+        std::array<uint32_t, BINS + 1> counts{};
+        uint32_t samples = 0;
+        uint32_t quantile = 0;
+        bool dirty = false;
+    };
+
+    uint32_t _margin;
+    uint32_t _minSamples;
+
+    typedef ByteMap<std::unique_ptr<Histogram>> AddressHistograms;
+
+    ByteMap<std::unique_ptr<AddressHistograms>> _histograms;  ///< histograms indexed by function and address
+
+    Histogram *_find(uint8_t address, uint8_t func);
+    void _copyHistograms(const AdaptiveTiming &other);
+};
+
+}  // namespace Modbus
+
+#endif /* !__Modbus_AdaptiveTiming__ */
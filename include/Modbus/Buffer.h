@@ -28,6 +28,8 @@
 #include <stdexcept>
 #include <vector>
 
+#include <Modbus/CRC.h>
+
 namespace Modbus {
 
 /**
@@ -63,6 +65,14 @@ public:
 /**
  * Represents a single Modbus message. Use BusList to organize a set of Modbus
  * messages or callbacks on various functions.
+ *
+ * CRC of the current frame is accumulated as data are written, so
+ * getCalcCrc and writeCRC don't need to rescan the buffer. Buffer hides
+ * std::vector methods which can modify data (operator[], at, data, begin,
+ * push_back, resize,..) - calling those marks the running CRC invalid, and
+ * the current frame is rescanned on the next getCalcCrc or writeCRC call.
+ * Size changes made through std::vector reference are detected as well, but
+ * in-place modifications made through std::vector reference aren't.
  */
 class Buffer : public std::vector<uint8_t> {
 public:
@@ -124,7 +134,11 @@ public:
     void writeI24(int32_t data);
 
     /**
-     * Returns current calculcated CRC.
+     * Returns current calculcated CRC. CRC is calculated from data written
+     * since the last writeCRC call. If the buffer was shrinked into the last
+     * terminated frame, CRC is calculated from that frame start, or from the
+     * buffer start if shrinked below it. Runs in O(1), unless the buffer was
+     * modified through std::vector methods.
      *
      * @return calculated CRC
      */
@@ -136,13 +150,24 @@ public:
      */
     void writeCRC();
 
+    /**
+     * Clears buffer and resets CRC counter.
+     */
+    void clear() {
+        std::vector<uint8_t>::clear();
+        _crc.reset();
+        _crcEnd = 0;
+        _frameStart = 0;
+        _lastFrameStart = 0;
+    }
+
     /**
      * Return address stored in the Modbus buffer. Essentially returns the
      * first byte.
      *
      * @return Buffer command address
      */
-    uint8_t address() { return at(0); }
+    uint8_t address() const { return std::vector<uint8_t>::at(0); }
 
     /**
      * Return function call stored in the Modbus buffer. Essentially returns
@@ -150,7 +175,7 @@ public:
      *
      * @return Function call code
      */
-    uint8_t func() { return at(1); }
+    uint8_t func() const { return std::vector<uint8_t>::at(1); }
 
     /**
      * Add to buffer Modbus function. Assumes subnet, data lengths and triggers are
@@ -173,22 +198,123 @@ public:
      */
     template <typename... dt>
     void callFunction(uint8_t address, uint8_t func, const dt&... params) {
+        _beginFrame();
         write(address);
         write(func);
         _functionArguments(params...);
         writeCRC();
     }
 
+    // std::vector methods which can modify data invalidate running CRC
+    reference operator[](size_type pos) {
+        _invalidateCrc();
+        return std::vector<uint8_t>::operator[](pos);
+    }
+    const_reference operator[](size_type pos) const { return std::vector<uint8_t>::operator[](pos); }
+    reference at(size_type pos) {
+        _invalidateCrc();
+        return std::vector<uint8_t>::at(pos);
+    }
+    const_reference at(size_type pos) const { return std::vector<uint8_t>::at(pos); }
+    reference front() {
+        _invalidateCrc();
+        return std::vector<uint8_t>::front();
+    }
+    const_reference front() const { return std::vector<uint8_t>::front(); }
+    reference back() {
+        _invalidateCrc();
+        return std::vector<uint8_t>::back();
+    }
+    const_reference back() const { return std::vector<uint8_t>::back(); }
+    value_type* data() {
+        _invalidateCrc();
+        return std::vector<uint8_t>::data();
+    }
+    const value_type* data() const { return std::vector<uint8_t>::data(); }
+    iterator begin() {
+        _invalidateCrc();
+        return std::vector<uint8_t>::begin();
+    }
+    const_iterator begin() const { return std::vector<uint8_t>::begin(); }
+    iterator end() {
+        _invalidateCrc();
+        return std::vector<uint8_t>::end();
+    }
+    const_iterator end() const { return std::vector<uint8_t>::end(); }
+    reverse_iterator rbegin() {
+        _invalidateCrc();
+        return std::vector<uint8_t>::rbegin();
+    }
+    const_reverse_iterator rbegin() const { return std::vector<uint8_t>::rbegin(); }
+    reverse_iterator rend() {
+        _invalidateCrc();
+        return std::vector<uint8_t>::rend();
+    }
+    const_reverse_iterator rend() const { return std::vector<uint8_t>::rend(); }
+    void push_back(uint8_t value) {
+        _invalidateCrc();
+        std::vector<uint8_t>::push_back(value);
+    }
+    void pop_back() {
+        _invalidateCrc();
+        std::vector<uint8_t>::pop_back();
+    }
+    template <typename... Args>
+    void resize(Args&&... args) {
+        _invalidateCrc();
+        std::vector<uint8_t>::resize(std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    void assign(Args&&... args) {
+        _invalidateCrc();
+        std::vector<uint8_t>::assign(std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    iterator insert(Args&&... args) {
+        _invalidateCrc();
+        return std::vector<uint8_t>::insert(std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    iterator erase(Args&&... args) {
+        _invalidateCrc();
+        return std::vector<uint8_t>::erase(std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        _invalidateCrc();
+        return std::vector<uint8_t>::emplace_back(std::forward<Args>(args)...);
+    }
+
 protected:
-    virtual void pushBuffer(uint8_t data) { push_back(data); }
+    virtual void pushBuffer(uint8_t data) {
+        if (_crcEnd == size()) {
+            _crc.add(data);
+            _crcEnd++;
+        }
+        std::vector<uint8_t>::push_back(data);
+    }
 
     inline void pushBuffer(uint8_t* data, std::size_t length) {
         for (std::size_t i = 0; i < length; i++) {
-            push_back(data[i]);
+            pushBuffer(data[i]);
         }
     }
 
 private:
+    CRC _crc;                         ///< running CRC of the current frame
+    std::size_t _crcEnd = 0;          ///< index of the first byte not yet included in _crc
+    std::size_t _frameStart = 0;      ///< start of the current frame - end of the last written CRC
+    std::size_t _lastFrameStart = 0;  ///< start of the last frame terminated with CRC
+
+    /**
+     * Marks running CRC invalid. Current frame is rescanned on the next
+     * getCalcCrc call.
+     */
+    void _invalidateCrc() { _crcEnd = SIZE_MAX; }
+
+    std::size_t _currentFrameStart();
+    void _beginFrame();
+
     void _functionArguments() {}
 
     template <typename dp1, typename... dt>
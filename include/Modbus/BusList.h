@@ -23,16 +23,22 @@
 #ifndef __Modbus_BusList__
 #define __Modbus_BusList__
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <list>
-#include <map>
+#include <type_traits>
 #include <vector>
 
 #include <spdlog/spdlog.h>
 
 #include <Modbus/Buffer.h>
+#include <Modbus/AdaptiveTiming.h>
+#include <Modbus/ByteMap.h>
+#include <Modbus/ChangeCache.h>
+#include <Modbus/Frame.h>
 #include <Modbus/Parser.h>
+#include <Modbus/TxEncoder.h>
 
 namespace Modbus {
 
@@ -102,6 +108,18 @@ public:
                       fmt::format("Unexpected response - received {} for address {}", address, func)) {}
 };
 
+/**
+ * Result of BusList::tryParse call.
+ */
+enum class ParseStatus {
+    OK,                   ///< response was parsed, its action was called
+    ERROR_HANDLED,        ///< error response was received, its error action was called
+    ERROR_RESPONSE,       ///< error response was received, no error action is defined
+    WRONG_RESPONSE,       ///< response doesn't match any command waiting for response
+    UNEXPECTED_RESPONSE,  ///< response action for the function code is undefined
+    NO_COMMAND            ///< all commands were already replied
+};
+
 /**
  * Utility class to hold command buffer with timinig data. BusList is a collection of those
  */
@@ -110,14 +128,43 @@ public:
     /**
      * Construct record for the command send.
      *
-     * @param _buffer Modbus buffer with command (address/function with possible arguments)
+     * @param _buffer Modbus frame with command (address/function with possible arguments)
+     * @param _timing Maximal response time in microseconds
+     */
+    CommandRecord(const Frame &_buffer, uint32_t _timing)
+            : buffer(_buffer), timing(_timing), serial(_nextSerial()) {}
+
+    /**
+     * Construct record with an empty frame. The frame shall be filled
+     * afterwards.
+     *
      * @param _timing Maximal response time in microseconds
      */
-    CommandRecord(Buffer _buffer, uint32_t _timing) : buffer(_buffer), timing(_timing) {}
+    explicit CommandRecord(uint32_t _timing) : timing(_timing), serial(_nextSerial()) {}
 
-    Buffer buffer;    ///< Buffer send to the bus
+    Frame buffer;     ///< Buffer send to the bus
     uint32_t timing;  ///< Timing value in microseconds. An error shall be thrown when the response isn't
                       ///< received in the specified time.
+    uint64_t serial;  ///< Unique record number. Used to detect records removed or replaced behind
+                      ///< BusList's back (through std::vector methods).
+
+private:
+    static uint64_t _nextSerial();
+};
+
+/**
+ * Identifies value in a command stored in a frozen BusList. Returned by
+ * BusList::slot, used to patch the value with BusList::patch.
+ *
+ * @tparam dt value data type
+ */
+template <typename dt>
+class Slot {
+public:
+    Slot(size_t _command, size_t _offset) : command(_command), offset(_offset) {}
+
+    size_t command;  ///< index of the command in BusList
+    size_t offset;   ///< offset of the value in command frame
 };
 
 /**
@@ -131,21 +178,30 @@ public:
      * @param _action Action to execute when function code is encountered
      * @param _error_action Error action
      */
-    ResponseRecord(std::function<void(Parser)> _action, std::function<void(uint8_t, uint8_t)> _error_action)
+    ResponseRecord(std::function<void(ParserView &)> _action,
+                   std::function<void(uint8_t, uint8_t)> _error_action)
             : action(_action), error_action(_error_action) {}
 
-    std::function<void(Parser)> action;                  ///< action to call on sucessfull response
+    /**
+     * Construct empty entry.
+     */
+    ResponseRecord() {}
+
+    std::function<void(ParserView &)> action;            ///< action to call on sucessfull response
     std::function<void(uint8_t, uint8_t)> error_action;  ///< action to call on the error response. Arguments
                                                          ///< are address and error /< code received from ILC
 };
 
 /**
  * Holds error statistics - last received error, its error code, time received
- * and number of errors so far.
+ * and number of errors so far. Values are atomic, so they can be read from
+ * other threads without locking.
  */
 class ErrorRecord {
 public:
     ErrorRecord();
+    ErrorRecord(const ErrorRecord &other);
+    ErrorRecord &operator=(const ErrorRecord &other);
 
     /**
      * Record error occurence.
@@ -155,10 +211,14 @@ public:
      */
     void record(uint8_t func, uint8_t error);
 
+    uint8_t get_last_error_function() const { return last_error_function.load(std::memory_order_relaxed); }
+    uint8_t get_last_error_code() const { return last_error_code.load(std::memory_order_relaxed); }
+    uint64_t get_error_count() const { return error_count.load(std::memory_order_relaxed); }
+
 private:
-    uint8_t last_error_function;
-    uint8_t last_error_code;
-    uint64_t error_count;
+    std::atomic<uint8_t> last_error_function;
+    std::atomic<uint8_t> last_error_code;
+    std::atomic<uint64_t> error_count;
 };
 
 /**
@@ -218,7 +278,13 @@ public:
      * @param timing function call timing in microseconds (1/10^-6 second)
      */
     void callFunction(uint8_t address, uint8_t func, uint32_t timing) {
-        emplace(end(), CommandRecord(Buffer(address, func), timing));
+        _checkFrozen();
+        emplace_back(timing).buffer.callFunction(address, func);
+        if (_unchanged(back().buffer)) {
+            pop_back();
+            return;
+        }
+        _encodePending();
     }
 
     /**
@@ -246,9 +312,208 @@ public:
      */
     template <typename... dt>
     void callFunction(uint8_t address, uint8_t func, uint32_t timing, const dt &...params) {
-        emplace(end(), CommandRecord(Buffer(address, func, params...), timing));
+        _checkFrozen();
+        auto &record = emplace_back(timing);
+        try {
+            record.buffer.callFunction(address, func, params...);
+        } catch (...) {
+            pop_back();
+            throw;
+        }
+        if (_unchanged(record.buffer)) {
+            pop_back();
+            return;
+        }
+        _encodePending();
     }
 
+    /**
+     * Removes all commands from the list. Unfreezes frozen list.
+     */
+    void clear() {
+        std::vector<CommandRecord>::clear();
+        _txEncoder.reset();
+        _frozen = false;
+        _patched.clear();
+        _anyPatched = false;
+    }
+
+    /**
+     * Freezes the list. Commands cannot be added to frozen list, but values
+     * in commands can be patched. This shall be used for commands send
+     * repeatedly, with only few values (e.g. setpoints) changing between
+     * cycles. Instead of rebuilding the list, the list is frozen and changing
+     * values are patched directly in command frames and encoded @glos{FPGA}
+     * words. CRCs of the patched frames are updated in applyPatches, called
+     * before the list is written to the @glos{FPGA} or transport.
+     *
+     * Call clear() to unfreeze the list.
+     *
+     * @code{.cpp}
+     * busList.callFunction(0, 75, 0, counter, values);
+     * busList.callFunction(5, 76, 300);
+     * busList.freeze();
+     * auto firstValue = busList.slot<int24_t>(0, 3);
+     *
+     * while (running) {
+     *     busList.patch(firstValue, int24_t(newValue));
+     *     fpga.ilcCommands(busList, 1000);
+     * }
+     * @endcode
+     */
+    void freeze();
+
+    /**
+     * Returns true if the list is frozen.
+     *
+     * @return true if list is frozen and values can be patched
+     */
+    bool frozen() const { return _frozen; }
+
+    /**
+     * Returns slot for the value in frozen list.
+     *
+     * @tparam dt value data type
+     *
+     * @param command command index
+     * @param offset value offset in command frame (including address and function code)
+     *
+     * @return slot to pass to patch method
+     *
+     * @throw std::runtime_error when the list isn't frozen
+     * @throw std::out_of_range when the value doesn't fit between function code and CRC
+     */
+    template <typename dt>
+    Slot<dt> slot(size_t command, size_t offset) {
+        if (_frozen == false) {
+            throw std::runtime_error("Slots can be created only in frozen bus list.");
+        }
+        size_t length = std::is_same<dt, int24_t>::value ? 3 : sizeof(dt);
+        if (offset < 2 || offset + length + 2 > at(command).buffer.size()) {
+            throw std::out_of_range(
+                    fmt::format("Invalid slot - offset {} length {} in command {} of length {}.", offset,
+                                length, command, at(command).buffer.size()));
+        }
+        return Slot<dt>(command, offset);
+    }
+
+    /**
+     * Patch value in frozen list.
+     *
+     * @tparam dt value data type
+     *
+     * @param slot value slot, obtained with slot() call
+     * @param value new value
+     */
+    template <typename dt>
+    void patch(const Slot<dt> &slot, dt value) {
+        Frame encoded;
+        encoded.write(value);
+        _patch(slot.command, slot.offset, encoded.data(), encoded.size());
+    }
+
+    /**
+     * Updates CRCs of patched commands. Called from encodeTx, shall be
+     * called by transports before patched command frames are send.
+     */
+    void applyPatches();
+
+    /**
+     * Returns commands encoded as @glos{FPGA} command FIFO words. Commands
+     * are encoded as they are added with callFunction, so only header and
+     * trailer are written. Commands added directly to the underlying vector
+     * are encoded here. Commands modified in place after they were added
+     * aren't re-encoded - call clear() and add them again.
+     *
+     * @param txCommand @glos{FPGA} command to transmit data on the bus
+     * @param trigger software trigger written after the commands
+     *
+     * @return words to write into the command FIFO
+     *
+     * @see TxEncoder
+     */
+    const std::vector<uint16_t> &encodeTx(uint16_t txCommand, uint16_t trigger) {
+        _encodePending();
+        applyPatches();
+        if (_adaptive) {
+            _adaptTiming();
+        }
+        return _txEncoder.seal(txCommand, trigger);
+    }
+
+    /**
+     * Enables or disables adaptive timing. When enabled, reply latencies
+     * reported with recordLatency are used to calculate tighter timing
+     * of commands, never exceeding timing passed to callFunction. Timing
+     * falls back to callFunction value after reply is missing.
+     *
+     * @param enabled true to enable adaptive timing
+     *
+     * @see AdaptiveTiming
+     */
+    void setAdaptiveTiming(bool enabled);
+
+    bool adaptiveTimingEnabled() const { return _adaptive; }
+
+    /**
+     * Returns adaptive timing used to calculate commands timing.
+     *
+     * @return adaptive timing
+     */
+    AdaptiveTiming &adaptiveTiming() { return _adaptiveTiming; }
+
+    /**
+     * Records observed reply latency. Ignored if adaptive timing isn't
+     * enabled.
+     *
+     * @param address Modbus address
+     * @param func Modbus function
+     * @param latency reply latency in microseconds
+     */
+    void recordLatency(uint8_t address, uint8_t func, uint32_t latency) {
+        if (_adaptive) {
+            _adaptiveTiming.record(address, func, latency);
+        }
+    }
+
+    /**
+     * Shall be called after all received responses were parsed. Marks
+     * commands without response as missed for adaptive timing.
+     */
+    void endResponses();
+
+    /**
+     * Suppresses calls of the function with arguments matching the last
+     * acknowledged call. Suppressed calls aren't added to the list, so
+     * neither the command nor its reply occupies the bus. Calls are send
+     * again after the change cache refresh period, after missing or error
+     * reply, or after cache for the address is invalidated.
+     *
+     * @code{.cpp}
+     * busList.suppressUnchanged(ILC_EM_CMD::SET_DCA_GAIN);
+     * // channel is the first argument
+     * busList.suppressUnchanged(ILC_EM_CMD::SET_OFFSET_AND_SENSITIVITY, true, 1);
+     * @endcode
+     *
+     * @param func Modbus function
+     * @param enabled true to suppress unchanged calls, false to always call
+     * the function
+     * @param keyBytes number of the function arguments bytes identifying
+     * value (e.g. channel), up to 2
+     *
+     * @see ChangeCache
+     */
+    void suppressUnchanged(uint8_t func, bool enabled = true, uint8_t keyBytes = 0) {
+        _changeCache.track(func, enabled, keyBytes);
+    }
+
+    /**
+     * Returns cache of acknowledged arguments.
+     *
+     * @return change cache
+     */
+    ChangeCache &changeCache() { return _changeCache; }
+
     /**
      * Returns number of expected bytes, given the reply so far received. Child
      * subclasses shall overwrite the method.
@@ -271,14 +536,68 @@ public:
      * @throw UnexpectedResponse Throwed when the bus list action for the
      * address/function (set with the add_response call) wasn't set.
      */
-    void parse(Parser parser);
+    void parse(ParserView parser);
+
+    /**
+     * Process @glos{ILC} response without throwing exceptions on unmatched
+     * responses. If response address and function doesn't match the next
+     * command, the commands are searched for the first matching command. All
+     * skipped commands, except broadcast commands, are treated as missing
+     * responses and recorded in ErrorRecord. Exceptions thrown from
+     * response actions (e.g. CRCError) are propagated.
+     *
+     * @param parser response to process
+     * @param skipped if not null, filled with number of missing responses
+     * skipped before the response
+     *
+     * @return processing status
+     *
+     * @see parse(ParserView)
+     * @see isBroadcast
+     */
+    ParseStatus tryParse(ParserView parser, size_t *skipped = nullptr);
+
+    /**
+     * Returns true if the response processed by the last tryParse call
+     * matched the command directly following the previously processed
+     * command. False when responses were missing or broadcasts (without
+     * response) were sent before the command. Response frame timing is
+     * measured from the end of the previous response, so it represents the
+     * command latency only for contiguous responses.
+     *
+     * @return true if the last parsed response followed the previous response
+     */
+    bool lastParsedContiguous() const { return _contiguous; }
+
+    /**
+     * Process response stored in the passed buffer. The data aren't copied.
+     *
+     * @see tryParse(ParserView, size_t*)
+     */
+    ParseStatus tryParse(const std::vector<uint8_t> &data, size_t *skipped = nullptr) {
+        return tryParse(ParserView(data.data(), data.size()), skipped);
+    }
+
+    /**
+     * Parse response stored in the passed data. The data aren't copied.
+     *
+     * @see ::parse(ParserView)
+     */
+    void parse(const uint8_t *data, size_t len) { parse(ParserView(data, len)); }
 
     /**
-     * Construct buffer from passed data and parse the response.
+     * Parse response stored in the passed buffer. The data aren't copied.
      *
-     * @see ::parse(Parser)
+     * @see ::parse(ParserView)
      */
-    void parse(uint8_t *data, size_t len) { parse(std::vector<uint8_t>(data, data + len)); }
+    void parse(const std::vector<uint8_t> &data) { parse(data.data(), data.size()); }
+
+    /**
+     * Parse response already stored in the parser.
+     *
+     * @see ::parse(ParserView)
+     */
+    void parse(const Parser &parser) { parse(ParserView(parser)); }
 
     /**
      * Add response callbacks. Both function code and error response code shall
@@ -298,9 +617,35 @@ public:
      *
      * @see checkCached
      */
-    void add_response(uint8_t func, std::function<void(Parser)> action,
+    void add_response(uint8_t func, std::function<void(ParserView &)> action,
                       std::function<void(uint8_t, uint8_t)> error_action = nullptr);
 
+    /**
+     * Add response callbacks receiving copy of the response. Provided for
+     * compatibility with callbacks written before ParserView was introduced -
+     * the response data are copied into the Parser before action is called.
+     * New code shall use ParserView callbacks.
+     *
+     * @param func callback for this function code
+     * @param action action to call when the response is found
+     * @param error_action action to call when error is found
+     */
+    void add_response(uint8_t func, std::function<void(Parser)> action,
+                      std::function<void(uint8_t, uint8_t)> error_action = nullptr) {
+        add_response(
+                func, [action](ParserView &parser) { action(Parser(parser)); }, error_action);
+    }
+
+    /**
+     * Returns true if address is broadcast address. Commands send to
+     * broadcast address aren't replied.
+     *
+     * @param address Modbus address
+     *
+     * @return true for Modbus broadcast address (0)
+     */
+    virtual bool isBroadcast(uint8_t address) { return address == 0; }
+
     /***
      * Called when response wasn't received.
      */
@@ -308,7 +653,15 @@ public:
 
     void set_error_response(uint8_t func, std::function<void(uint8_t, uint8_t)> error_action);
 
-    ErrorRecord get_error_record(uint8_t address) { return _errors[address]; }
+    /**
+     * Returns error statistics for the address. Can be called from other
+     * threads.
+     *
+     * @param address Modbus address
+     *
+     * @return error statistics
+     */
+    ErrorRecord get_error_record(uint8_t address) const { return _errors.value(address); }
 
     /**
      * Modbus error mask. If the first bit is set in reply funcion code, the
@@ -317,10 +670,41 @@ public:
     static constexpr uint8_t MODBUS_ERROR_MASK = 0x80;
 
 private:
-    std::map<uint8_t, ResponseRecord> _functions;
-    std::map<uint8_t, ErrorRecord> _errors;
+    ByteMap<ResponseRecord> _functions;
+    TxEncoder _txEncoder;
+
+    bool _adaptive = false;
+    AdaptiveTiming _adaptiveTiming;
+
+    ChangeCache _changeCache;
+
+    bool _frozen = false;
+    std::vector<bool> _patched;
+    bool _anyPatched = false;
+    ByteMap<ErrorRecord> _errors;
 
     size_t _parsed_index = 0;
+    bool _contiguous = false;
+    uint64_t _lastEncoded = 0;
+
+    void _encodePending();
+    void _adaptTiming();
+    void _missed(const Frame &command);
+
+    bool _unchanged(const Frame &command) {
+        return _changeCache.tracked(command.func()) && isBroadcast(command.address()) == false &&
+               _changeCache.unchanged(command);
+    }
+
+    ParseStatus _process(ParserView &parser, uint8_t address, uint8_t called);
+
+    void _checkFrozen() {
+        if (_frozen) {
+            throw std::runtime_error("Cannot add commands to frozen bus list - clear it first.");
+        }
+    }
+
+    void _patch(size_t command, size_t offset, const uint8_t *data, size_t length);
 };
 
 }  // namespace Modbus
@@ -0,0 +1,228 @@
+/*
+ * Map indexed by a single byte.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Modbus_ByteMap__
+#define __Modbus_ByteMap__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/fmt/fmt.h>
+
+namespace Modbus {
+
+/**
+ * Map with uint8_t keys (Modbus addresses or function codes), stored as
+ * directly indexed array of 256 values and bitmap of present keys. Lookup is
+ * a single indexed load. Presence bitmap is atomic - a value stored with set
+ * can be read from other thread without locking, providing the value itself
+ * is safe to read (e.g. is atomic).
+ *
+ * @tparam T value type. Shall be default constructible.
+ */
+template <typename T>
+class ByteMap {
+public:
+    ByteMap() { clear(); }
+
+    /**
+     * Copies values and presence bitmap. Atomic values are copied with plain
+     * loads. The other map shall not be modified during copy.
+     *
+     * @param other map to copy
+     */
+    ByteMap(const ByteMap &other) { *this = other; }
+
+    ByteMap(ByteMap &&other) { *this = std::move(other); }
+
+    ByteMap &operator=(const ByteMap &other) {
+        for (size_t i = 0; i < _values.size(); i++) {
+            _copy(_values[i], other._values[i]);
+        }
+        _copyPresent(other);
+        return *this;
+    }
+
+    ByteMap &operator=(ByteMap &&other) {
+        for (size_t i = 0; i < _values.size(); i++) {
+            _move(_values[i], other._values[i]);
+        }
+        _copyPresent(other);
+        return *this;
+    }
+
+    /**
+     * Returns true if value for the key was set.
+     *
+     * @param key map key
+     *
+     * @return true if key is present in the map
+     */
+    bool contains(uint8_t key) const {
+        return _present[key >> 6].load(std::memory_order_acquire) & (1ULL << (key & 0x3F));
+    }
+
+    /**
+     * Returns value for the key, marking the key as present.
+     *
+     * @param key map key
+     *
+     * @return value reference
+     */
+    T &operator[](uint8_t key) {
+        _mark(key);
+        return _values[key];
+    }
+
+    /**
+     * Returns value for the present key.
+     *
+     * @param key map key
+     *
+     * @return value reference
+     *
+     * @throw std::out_of_range if the key isn't present
+     */
+    T &at(uint8_t key) {
+        _check(key);
+        return _values[key];
+    }
+
+    const T &at(uint8_t key) const {
+        _check(key);
+        return _values[key];
+    }
+
+    /**
+     * Returns pointer to value for the key.
+     *
+     * @param key map key
+     *
+     * @return pointer to value, nullptr if the key isn't present
+     */
+    T *find(uint8_t key) { return contains(key) ? &_values[key] : nullptr; }
+
+    const T *find(uint8_t key) const { return contains(key) ? &_values[key] : nullptr; }
+
+    /**
+     * Returns value stored for the key, regardless of the key presence. Not
+     * present keys have default constructed value.
+     *
+     * @param key map key
+     *
+     * @return value reference
+     */
+    const T &value(uint8_t key) const { return _values[key]; }
+
+    /**
+     * Sets value for the key. The key is marked as present after value is
+     * stored.
+     *
+     * @param key map key
+     * @param value new value
+     */
+    template <typename V>
+    void set(uint8_t key, const V &value) {
+        _values[key] = value;
+        _mark(key);
+    }
+
+    /**
+     * Sets value for the key if the key isn't present.
+     *
+     * @param key map key
+     * @param value new value
+     *
+     * @return true if value was stored, false if key was already present
+     */
+    bool emplace(uint8_t key, const T &value) {
+        if (contains(key)) {
+            return false;
+        }
+        set(key, value);
+        return true;
+    }
+
+    /**
+     * Removes key from the map. The value isn't destroyed.
+     *
+     * @param key map key
+     */
+    void erase(uint8_t key) {
+        _present[key >> 6].fetch_and(~(1ULL << (key & 0x3F)), std::memory_order_release);
+    }
+
+    /**
+     * Removes all keys.
+     */
+    void clear() {
+        for (auto &p : _present) {
+            p.store(0, std::memory_order_release);
+        }
+    }
+
+private:
+    std::array<T, 256> _values{};
+    std::array<std::atomic<uint64_t>, 4> _present;
+
+    void _mark(uint8_t key) { _present[key >> 6].fetch_or(1ULL << (key & 0x3F), std::memory_order_release); }
+
+    template <typename V>
+    static void _copy(V &dst, const V &src) {
+        dst = src;
+    }
+
+    template <typename V>
+    static void _copy(std::atomic<V> &dst, const std::atomic<V> &src) {
+        dst.store(src.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    template <typename V>
+    static void _move(V &dst, V &src) {
+        dst = std::move(src);
+    }
+
+    template <typename V>
+    static void _move(std::atomic<V> &dst, std::atomic<V> &src) {
+        _copy(dst, src);
+    }
+
+    void _copyPresent(const ByteMap &other) {
+        for (size_t i = 0; i < _present.size(); i++) {
+            _present[i].store(other._present[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    void _check(uint8_t key) const {
+        if (contains(key) == false) {
+            throw std::out_of_range(fmt::format("Key {} not found", key));
+        }
+    }
+};
+
+}  // namespace Modbus
+
+#endif /* !__Modbus_ByteMap__ */
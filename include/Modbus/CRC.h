@@ -23,6 +23,8 @@
 #ifndef __Modbus_CRC__
 #define __Modbus_CRC__
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -40,6 +42,11 @@ namespace Modbus {
  * std::cout << "Modbus CRC is " << crc.get() << "(0x" << << std::setw(4) << std::setfill('0')
  *     << std::hex << crc.get() << ")" << std::endl;
  * @endcode
+ *
+ * The CRC is table driven. Lookup tables are generated at compile time. Longer
+ * buffers passed to update are processed 8 (and then 4) bytes at a time
+ * (slice-by-8 algorithm), shorter buffers and single bytes use the single
+ * table lookup per byte.
  */
 class CRC {
 public:
@@ -49,11 +56,14 @@ public:
      */
     CRC() { reset(); }
 
+    /**
+     * Construct CRC class and calculates CRC of the vector data.
+     *
+     * @param vec data vector
+     */
     CRC(const std::vector<uint8_t>& vec) {
         reset();
-        for (auto data : vec) {
-            add(data);
-        }
+        update(vec.data(), vec.size());
     }
 
     /**
@@ -62,11 +72,9 @@ public:
      * @param buf data buffer
      * @param len data length
      */
-    CRC(uint8_t* data, std::size_t len) {
+    CRC(const uint8_t* data, std::size_t len) {
         reset();
-        for (std::size_t i = 0; i < len; i++) {
-            add(data[i]);
-        }
+        update(data, len);
     }
 
     /**
@@ -79,17 +87,34 @@ public:
      *
      * @param data data to be added
      */
-    void add(uint8_t data);
+    void add(uint8_t data) { _crcCounter = (_crcCounter >> 8) ^ _table[0][(_crcCounter ^ data) & 0xFF]; }
+
+    /**
+     * Adds data buffer to CRC. Updates CRC value to match previous data. Can
+     * be called repeatedly to calculate CRC of data arriving in chunks.
+     *
+     * @param data data to be added
+     * @param len data length
+     */
+    void update(const uint8_t* data, std::size_t len);
 
     /**
      * Returns CRC value.
      *
      * @return buffer Modbus CRC
      */
-    uint16_t get() { return _crcCounter; }
+    uint16_t get() const { return _crcCounter; }
+
+    /**
+     * Number of lookup tables, and hence maximal number of bytes processed in
+     * a single step.
+     */
+    static constexpr std::size_t SLICES = 8;
 
 private:
     uint16_t _crcCounter;
+
+    static const std::array<std::array<uint16_t, 256>, SLICES> _table;
 };
 
 }  // namespace Modbus
@@ -0,0 +1,160 @@
+/*
+ * Cache of the last acknowledged Modbus command arguments.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Modbus_ChangeCache__
+#define __Modbus_ChangeCache__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <Modbus/ByteMap.h>
+#include <Modbus/Frame.h>
+
+namespace Modbus {
+
+/**
+ * Remembers arguments of the last acknowledged (replied without error) call
+ * of tracked functions. Commands setting device parameters (gains, offsets,
+ * ..) don't need to be send again if the device already confirmed the same
+ * arguments - and skipping those saves the command round trip on the bus.
+ *
+ * Values are stored per address and function. Some functions set a value
+ * for a channel passed as the first argument - for those, number of key
+ * bytes can be specified, and values are stored per address, function and
+ * the key bytes.
+ *
+ * The cached value is forgotten if the command reply is missing or is error
+ * reply. As the device can lose its parameters without notice (e.g. on
+ * reset or power cycle), cached values expire after the refresh period, so
+ * commands are periodically send even if unchanged.
+ *
+ * @see BusList::suppressUnchanged
+ */
+class ChangeCache {
+public:
+    typedef std::chrono::steady_clock clock;
+
+    /**
+     * Constructs cache.
+     *
+     * @param refreshPeriod period after which unchanged commands are send
+     * again. Zero disables suppression of unchanged commands
+     */
+    ChangeCache(clock::duration refreshPeriod = std::chrono::seconds(60));
+
+    /**
+     * Starts or stops tracking of the function.
+     *
+     * @param func Modbus function
+     * @param enabled true to track the function
+     * @param keyBytes number of argument bytes (up to 2) identifying value
+     * (e.g. channel number)
+     *
+     * @throw std::out_of_range if keyBytes is greater than 2
+     */
+    void track(uint8_t func, bool enabled = true, uint8_t keyBytes = 0);
+
+    /**
+     * Returns true if the function is tracked.
+     *
+     * @param func Modbus function
+     *
+     * @return true if function is tracked
+     */
+    bool tracked(uint8_t func) const { return _tracked.contains(func); }
+
+    /**
+     * Checks if the command arguments match the last acknowledged values.
+     * Counts the command as suppressed if it does.
+     *
+     * @param command command frame, including CRC
+     * @param now current time
+     *
+     * @return true if arguments match the acknowledged values and the values
+     * were acknowledged in the refresh period
+     */
+    bool unchanged(const Frame &command, clock::time_point now = clock::now());
+
+    /**
+     * Stores the command arguments as the acknowledged values.
+     *
+     * @param command command frame, including CRC
+     * @param now time the command was acknowledged
+     */
+    void acknowledge(const Frame &command, clock::time_point now = clock::now());
+
+    /**
+     * Forgets the values of the function for the address.
+     *
+     * @param address Modbus address
+     * @param func Modbus function
+     */
+    void invalidate(uint8_t address, uint8_t func);
+
+    /**
+     * Forgets all values for the address. Shall be called when the device
+     * is known to lose its parameters (e.g. was reset).
+     *
+     * @param address Modbus address
+     */
+    void invalidate(uint8_t address);
+
+    /**
+     * Forgets all cached values. Tracked functions remain tracked.
+     */
+    void clear() { _values.clear(); }
+
+    clock::duration getRefreshPeriod() const { return _refreshPeriod; }
+
+    void setRefreshPeriod(clock::duration refreshPeriod) { _refreshPeriod = refreshPeriod; }
+
+    /**
+     * Returns number of commands reported as unchanged.
+     *
+     * @return number of suppressed commands
+     */
+    uint64_t suppressed() const { return _suppressed; }
+
+private:
+    struct Value {
+        std::vector<uint8_t> arguments;
+        clock::time_point acknowledged;
+    };
+
+    clock::duration _refreshPeriod;
+    ByteMap<uint8_t> _tracked;
+    std::map<uint32_t, Value> _values;
+    uint64_t _suppressed = 0;
+
+    uint32_t _key(const Frame &command) const;
+
+    static uint32_t _prefix(uint8_t address, uint8_t func) {
+        return (static_cast<uint32_t>(address) << 24) | (static_cast<uint32_t>(func) << 16);
+    }
+};
+
+}  // namespace Modbus
+
+#endif /* !__Modbus_ChangeCache__ */
@@ -0,0 +1,313 @@
+/*
+ * Fixed capacity Modbus frame.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Modbus_Frame__
+#define __Modbus_Frame__
+
+#include <arpa/inet.h>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <Modbus/Buffer.h>
+#include <Modbus/CRC.h>
+
+namespace Modbus {
+
+/**
+ * Single Modbus frame (address, function, arguments and CRC) stored in a
+ * fixed size array. As Modbus RTU frame (ADU) cannot be longer than 256 bytes,
+ * the frame doesn't need to allocate any memory on heap. Provides the same
+ * write and CRC interface as Buffer, and is used in CommandRecord to store
+ * commands send to the bus.
+ *
+ * CRC is accumulated as data are written, so writeCRC only appends the
+ * calculated value.
+ *
+ * @see Buffer
+ */
+class Frame {
+public:
+    /**
+     * Maximal Modbus RTU frame length.
+     */
+    static constexpr std::size_t MAX_LENGTH = 256;
+
+    /**
+     * Construct an empty frame.
+     */
+    Frame() : _length(0) {}
+
+    /**
+     * Construct frame for a given Modbus function.
+     *
+     * @param address ModBus address on subnet
+     * @param func ModBus function to call
+     * @param params ModBus command arguments.
+     */
+    template <typename... dt>
+    Frame(uint8_t address, uint8_t func, const dt&... params) : _length(0) {
+        callFunction(address, func, params...);
+    }
+
+    /**
+     * Write a value to the frame.
+     *
+     * @tparam dt value data type. Supported are uint8_t, uint16_t, uint32_t,
+     * int8_t, int16_t, int32_t, int24_t and float.
+     *
+     * @param data value to write to the frame
+     *
+     * @throw std::out_of_range when the frame is full
+     */
+    template <typename dt>
+    void write(dt data);
+
+    /**
+     * Write all vector values to the frame.
+     *
+     * @param data values to write
+     */
+    template <typename vt>
+    void write(const std::vector<vt>& data) {
+        for (auto d : data) {
+            write<vt>(d);
+        }
+    }
+
+    /**
+     * Write all array values to the frame.
+     *
+     * @param data values to write
+     */
+    template <typename vt, std::size_t N>
+    void write(const std::array<vt, N>& data) {
+        for (auto d : data) {
+            write<vt>(d);
+        }
+    }
+
+    /**
+     * Writes 24bit signed integer.
+     *
+     * @param data 24bit signed integer
+     *
+     * @see write
+     */
+    void writeI24(int32_t data);
+
+    /**
+     * Returns current calculcated CRC - CRC of data written after last
+     * writeCRC call.
+     *
+     * @return calculated CRC
+     */
+    uint16_t getCalcCrc() const { return _crc.get(); }
+
+    /**
+     * Writes CRC for all data already written. Reset internal CRC counter, so
+     * frame can accept more data.
+     */
+    void writeCRC();
+
+    /**
+     * Overwrites already written data. Frame CRC isn't updated - call
+     * updateCRC after all data were patched.
+     *
+     * @param offset offset of the first byte to overwrite
+     * @param data new data
+     * @param length data length
+     *
+     * @throw std::out_of_range when patched data extend beyond frame end
+     */
+    void patch(std::size_t offset, const uint8_t* data, std::size_t length);
+
+    /**
+     * Overwrites already written value. Value is encoded the same way as
+     * write encodes it.
+     *
+     * @tparam dt value data type
+     *
+     * @param offset offset of the value in frame
+     * @param value new value
+     *
+     * @see write
+     */
+    template <typename dt>
+    void patch(std::size_t offset, dt value) {
+        Frame encoded;
+        encoded.write(value);
+        patch(offset, encoded.data(), encoded.size());
+    }
+
+    /**
+     * Recalculates CRC stored in the last two frame bytes. Shall be called
+     * after frame was patched.
+     */
+    void updateCRC();
+
+    /**
+     * Return address stored in the frame. Essentially returns the first byte.
+     *
+     * @return frame command address
+     */
+    uint8_t address() const { return _data[0]; }
+
+    /**
+     * Return function code stored in the frame. Essentially returns the
+     * second byte.
+     *
+     * @return Function call code
+     */
+    uint8_t func() const { return _data[1]; }
+
+    /**
+     * Add to the frame Modbus function.
+     *
+     * @param address ModBus address on subnet
+     * @param func ModBus function to call
+     */
+    void callFunction(uint8_t address, uint8_t func);
+
+    /**
+     * Call Modbus function with one or more parameter.
+     *
+     * @tparam dt parameter type
+     * @param address ModBus address on subnet
+     * @param func ModBus function to call
+     * @param params function parameters
+     */
+    template <typename... dt>
+    void callFunction(uint8_t address, uint8_t func, const dt&... params) {
+        write(address);
+        write(func);
+        _functionArguments(params...);
+        writeCRC();
+    }
+
+    /**
+     * Clears the frame.
+     */
+    void clear() {
+        _length = 0;
+        _crc.reset();
+    }
+
+    std::size_t size() const { return _length; }
+    bool empty() const { return _length == 0; }
+
+    uint8_t* data() { return _data.data(); }
+    const uint8_t* data() const { return _data.data(); }
+
+    uint8_t* begin() { return _data.data(); }
+    uint8_t* end() { return _data.data() + _length; }
+    const uint8_t* begin() const { return _data.data(); }
+    const uint8_t* end() const { return _data.data() + _length; }
+
+    uint8_t& operator[](std::size_t i) { return _data[i]; }
+    const uint8_t& operator[](std::size_t i) const { return _data[i]; }
+
+protected:
+    void pushBuffer(uint8_t data) {
+        if (_length >= MAX_LENGTH) {
+            throw std::out_of_range(
+                    "Cannot write beyond Modbus frame end - maximal frame length is 256 bytes.");
+        }
+        _crc.add(data);
+        _data[_length++] = data;
+    }
+
+    void pushBuffer(const uint8_t* data, std::size_t length) {
+        for (std::size_t i = 0; i < length; i++) {
+            pushBuffer(data[i]);
+        }
+    }
+
+private:
+    std::array<uint8_t, MAX_LENGTH> _data;
+    uint16_t _length;
+    CRC _crc;
+
+    void _functionArguments() {}
+
+    template <typename dp1, typename... dt>
+    void _functionArguments(const dp1& p1, const dt&... args) {
+        write(p1);
+        _functionArguments(args...);
+    }
+};
+
+template <>
+inline void Frame::write(int8_t data) {
+    pushBuffer(reinterpret_cast<uint8_t*>(&data), 1);
+}
+
+template <>
+inline void Frame::write(int16_t data) {
+    int16_t d = htons(data);
+    pushBuffer(reinterpret_cast<uint8_t*>(&d), 2);
+}
+
+template <>
+inline void Frame::write(int24_t data) {
+    writeI24(data.value);
+}
+
+template <>
+inline void Frame::write(int32_t data) {
+    int32_t d = htonl(data);
+    pushBuffer(reinterpret_cast<uint8_t*>(&d), 4);
+}
+
+template <>
+inline void Frame::write(uint8_t data) {
+    pushBuffer(data);
+}
+
+template <>
+inline void Frame::write(uint16_t data) {
+    uint16_t d = htons(data);
+    pushBuffer(reinterpret_cast<uint8_t*>(&d), 2);
+}
+
+template <>
+inline void Frame::write(uint32_t data) {
+    uint32_t d = htonl(data);
+    pushBuffer(reinterpret_cast<uint8_t*>(&d), 4);
+}
+
+template <>
+inline void Frame::write(uint64_t data) {
+    uint64_t d = htobe64(data);
+    pushBuffer(reinterpret_cast<uint8_t*>(&d), 8);
+}
+
+template <>
+inline void Frame::write(float data) {
+    uint32_t* db = reinterpret_cast<uint32_t*>(&data);
+    write<uint32_t>(*db);
+}
+
+}  // namespace Modbus
+
+#endif /* !__Modbus_Frame__ */
@@ -34,6 +34,7 @@
 #include <spdlog/fmt/fmt.h>
 
 #include <Modbus/Buffer.h>
+#include <Modbus/Frame.h>
 
 namespace Modbus {
 
@@ -88,27 +89,36 @@ public:
      * @param buf Buffer with data received
      * @param len Buffer length
      */
-    LongResponse(uint8_t *buf, size_t len)
+    LongResponse(const uint8_t *buf, size_t len)
             : std::runtime_error(std::string("Too long response - received ") + hexDump(buf, len)) {}
 };
 
 /**
- * Class parsing a single Modbus response.
+ * Parses a single Modbus response stored in an external buffer. The view
+ * doesn't own nor copy the data - the buffer must outlive the view. Used to
+ * pass responses to BusList callbacks without copying them.
  */
-class Parser : public std::vector<uint8_t> {
+class ParserView {
 public:
     /**
-     * Construct parser from given input data. Essentially only store the data
-     * into buffer.
+     * Construct view of the given data.
      *
-     * @param buffer Buffer to parse
+     * @param data response data
+     * @param len data length
+     *
+     * @throw std::runtime_error if data are shorter than minimal Modbus response
      */
-    Parser(std::vector<uint8_t> buffer) { parse(buffer); }
+    ParserView(const uint8_t *data, size_t len) { view(data, len); }
 
     /**
-     * Sets the given buffer as the one to be parsed.
+     * Sets the given data as the one to be parsed.
+     *
+     * @param data response data
+     * @param len data length
+     *
+     * @throw std::runtime_error if data are shorter than minimal Modbus response
      */
-    void parse(std::vector<uint8_t> buffer);
+    void view(const uint8_t *data, size_t len);
 
     /**
      * Check that so far read data CRC matches calculated CRC.
@@ -130,12 +140,8 @@ public:
      * @param len how many bytes shall be read
      */
     void readBuffer(void *buf, size_t len) {
-        if (_data + len > size()) {
-            throw std::out_of_range(fmt::format(
-                    "Attempt to access data beyond buffer end (buffer index {}, but buffer length is {}).",
-                    _data + len, size()));
-        }
-        memcpy(buf, data() + _data, len);
+        _checkLength(len);
+        memcpy(buf, _buffer + _data, len);
         _data += len;
     }
 
@@ -180,7 +186,7 @@ public:
      *
      * @return Modbus command address
      */
-    const uint8_t address() { return at(0); }
+    const uint8_t address() const { return _buffer[0]; }
 
     /**
      * Returns function code from the Modbus buffer. Actually returns the
@@ -188,10 +194,121 @@ public:
      *
      * @return Modbus function code
      */
-    const uint8_t func() { return at(1); }
+    const uint8_t func() const { return _buffer[1]; }
+
+    /**
+     * Returns viewed data.
+     *
+     * @return pointer to response data
+     */
+    const uint8_t *data() const { return _buffer; }
+
+    /**
+     * Returns viewed data length.
+     *
+     * @return response length
+     */
+    size_t size() const { return _length; }
+
+protected:
+    ParserView() {}
+
+    const uint8_t *_buffer = nullptr;  ///< Parsed data.
+    size_t _length = 0;                ///< Parsed data length.
+    size_t _data = 0;                  ///< Data pointer.
+
+private:
+    void _checkLength(size_t len) {
+        if (_data + len > _length) {
+            throw std::out_of_range(fmt::format(
+                    "Attempt to access data beyond buffer end (buffer index {}, but buffer length is {}).",
+                    _data + len, _length));
+        }
+    }
+};
+
+/**
+ * Class parsing a single Modbus response. Owns copy of the parsed data.
+ * Parsed data are stored in a vector, which is exposed only for reading -
+ * modifying it (e.g. push_back or resize) could reallocate the data and
+ * leave the view dangling. Use parse to change parsed data.
+ *
+ * @see ParserView
+ */
+class Parser : private std::vector<uint8_t>, public ParserView {
+public:
+    /**
+     * Construct parser from given input data. Essentially only store the data
+     * into buffer.
+     *
+     * @param buffer Buffer to parse
+     */
+    Parser(std::vector<uint8_t> buffer) { parse(buffer); }
+
+    /**
+     * Construct parser from a Modbus frame.
+     *
+     * @param frame Frame to parse
+     */
+    Parser(const Frame &frame) { parse(frame); }
+
+    /**
+     * Construct parser from parser view. Copies viewed data, including current
+     * read position.
+     *
+     * @param view view to copy
+     */
+    explicit Parser(const ParserView &view) : ParserView(view) {
+        assign(view.data(), view.data() + view.size());
+        _rebind();
+    }
+
+    Parser(const Parser &other) : std::vector<uint8_t>(other), ParserView(other) { _rebind(); }
+
+    Parser &operator=(const Parser &other) {
+        std::vector<uint8_t>::operator=(other);
+        ParserView::operator=(other);
+        _rebind();
+        return *this;
+    }
+
+    using std::vector<uint8_t>::at;
+    using std::vector<uint8_t>::begin;
+    using std::vector<uint8_t>::cbegin;
+    using std::vector<uint8_t>::cend;
+    using std::vector<uint8_t>::data;
+    using std::vector<uint8_t>::empty;
+    using std::vector<uint8_t>::end;
+    using std::vector<uint8_t>::operator[];
+    using std::vector<uint8_t>::size;
+
+    /**
+     * Returns parsed data.
+     *
+     * @return vector with parsed data
+     */
+    const std::vector<uint8_t> &buffer() const { return *this; }
+
+    /**
+     * Sets the given buffer as the one to be parsed.
+     */
+    void parse(std::vector<uint8_t> buffer) { parse(buffer.data(), buffer.size()); }
+
+    /**
+     * Sets the given frame as the one to be parsed.
+     */
+    void parse(const Frame &frame) { parse(frame.data(), frame.size()); }
+
+    /**
+     * Sets the given data as the one to be parsed.
+     *
+     * @param data data to parse
+     * @param len data length
+     */
+    void parse(const uint8_t *data, size_t len);
 
 private:
-    size_t _data = 0;  ///< Data pointer.
+    void _rebind() { _buffer = std::vector<uint8_t>::data(); }
 };
 
 /**
@@ -200,7 +317,7 @@ private:
  * @return 24 bites value read from the buffer.
  */
 template <>
-inline int24_t Parser::read() {
+inline int24_t ParserView::read() {
     int32_t db = 0;
     readBuffer(&db, 3);
     // handle properly negative values
@@ -212,42 +329,41 @@ inline int24_t Parser::read() {
 }
 
 template <>
-inline int32_t Parser::read() {
+inline int32_t ParserView::read() {
     int32_t db;
     readBuffer(&db, 4);
     return ntohl(db);
 }
 
 template <>
-inline uint8_t Parser::read() {
-    uint8_t ret;
-    readBuffer(&ret, 1);
-    return ret;
+inline uint8_t ParserView::read() {
+    _checkLength(1);
+    return _buffer[_data++];
 }
 
 template <>
-inline uint16_t Parser::read() {
+inline uint16_t ParserView::read() {
     uint16_t db;
     readBuffer(&db, 2);
     return ntohs(db);
 }
 
 template <>
-inline uint32_t Parser::read() {
+inline uint32_t ParserView::read() {
     uint32_t db;
     readBuffer(&db, 4);
     return ntohl(db);
 }
 
 template <>
-inline uint64_t Parser::read() {
+inline uint64_t ParserView::read() {
     uint64_t db;
     readBuffer(&db, 8);
     return be64toh(db);
 }
 
 template <>
-inline float Parser::read() {
+inline float ParserView::read() {
     uint32_t d = read<uint32_t>();
     float *db = reinterpret_cast<float *>(&d);
     return *db;
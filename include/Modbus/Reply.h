@@ -0,0 +1,208 @@
+/*
+ * Compile-time Modbus reply schemas.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Modbus_Reply__
+#define __Modbus_Reply__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <Modbus/Buffer.h>
+#include <Modbus/CRC.h>
+#include <Modbus/Parser.h>
+
+namespace Modbus {
+
+/**
+ * Size of a value in Modbus frame.
+ *
+ * @tparam dt value data type
+ */
+template <typename dt>
+struct ReplyField {
+    static_assert(std::is_arithmetic<dt>::value, "Unsupported reply field type");
+    static constexpr size_t size = sizeof(dt);
+};
+
+template <>
+struct ReplyField<int24_t> {
+    static constexpr size_t size = 3;
+};
+
+/**
+ * Schema of a fixed length Modbus reply. Reply consists of address, function
+ * code, values of the given types (encoded in big endian, as in Modbus) and
+ * CRC. Offsets of the values and the reply length are known at compile time,
+ * so the reply is decoded in a single pass, without per-value bounds checks.
+ *
+ * Reply actions shall be registered with ILC::ILCBusList::addReply, which
+ * also registers reply length, or with BusList::add_response and action().
+ *
+ * @code{.cpp}
+ * typedef Modbus::Reply<uint8_t, int32_t, float> StepperForceStatus;
+ *
+ * addReply<StepperForceStatus>(67, [this](uint8_t address, uint8_t status, int32_t encoder, float force) {
+ *     processStepperForceStatus(address, status, encoder, force);
+ * });
+ * @endcode
+ *
+ * @tparam dt reply values data types. Supported are uint8_t, int8_t,
+ * uint16_t, int16_t, int24_t, uint32_t, int32_t, uint64_t and float.
+ */
+template <typename... dt>
+class Reply {
+public:
+    typedef std::tuple<dt...> values_type;
+
+    /**
+     * Length of reply values.
+     */
+    static constexpr size_t DATA_LENGTH = (ReplyField<dt>::size + ... + 0);
+
+    /**
+     * Total reply length - address, function code, values and CRC.
+     */
+    static constexpr size_t LENGTH = 2 + DATA_LENGTH + 2;
+
+    /**
+     * Checks reply length and CRC.
+     *
+     * @param data reply data
+     * @param length reply length
+     *
+     * @throw std::out_of_range if reply is too short
+     * @throw CRCError if CRC doesn't match
+     * @throw LongResponse if reply is too long
+     */
+    static void check(const uint8_t *data, size_t length) {
+        if (length < LENGTH) {
+            throw std::out_of_range(
+                    fmt::format("Reply too short - expected {} bytes, received {}.", LENGTH, length));
+        }
+        uint16_t calculated = CRC(data, LENGTH - 2).get();
+        uint16_t received = data[LENGTH - 2] | (data[LENGTH - 1] << 8);
+        if (calculated != received) {
+            throw CRCError(calculated, received);
+        }
+        if (length > LENGTH) {
+            throw LongResponse(data + LENGTH, length - LENGTH);
+        }
+    }
+
+    /**
+     * Checks and decodes reply.
+     *
+     * @param data reply data
+     * @param length reply length
+     *
+     * @return tuple with reply values
+     *
+     * @see check
+     */
+    static values_type parse(const uint8_t *data, size_t length) {
+        check(data, length);
+        return _decode(data, std::index_sequence_for<dt...>{});
+    }
+
+    static values_type parse(const ParserView &parser) { return parse(parser.data(), parser.size()); }
+
+    /**
+     * Checks and decodes reply, and calls callback with the reply address and
+     * decoded values.
+     *
+     * @param parser reply to decode
+     * @param callback callback called with address and reply values
+     *
+     * @see check
+     */
+    template <typename Callback>
+    static void dispatch(const ParserView &parser, Callback &&callback) {
+        check(parser.data(), parser.size());
+        _dispatch(parser.data(), callback, std::index_sequence_for<dt...>{});
+    }
+
+    /**
+     * Returns action for BusList::add_response.
+     *
+     * @param callback callback called with address and reply values
+     *
+     * @return action decoding the reply and calling the callback
+     */
+    template <typename Callback>
+    static std::function<void(ParserView &)> action(Callback callback) {
+        return [callback](ParserView &parser) { dispatch(parser, callback); };
+    }
+
+private:
+    static constexpr std::array<size_t, sizeof...(dt)> OFFSETS = [] {
+        std::array<size_t, sizeof...(dt)> ret{};
+        size_t sizes[] = {ReplyField<dt>::size..., 0};
+        size_t offset = 2;
+        for (size_t i = 0; i < sizeof...(dt); i++) {
+            ret[i] = offset;
+            offset += sizes[i];
+        }
+        return ret;
+    }();
+
+    template <size_t... I>
+    static values_type _decode(const uint8_t *data, std::index_sequence<I...>) {
+        return values_type(_value<dt>(data + OFFSETS[I])...);
+    }
+
+    template <typename Callback, size_t... I>
+    static void _dispatch(const uint8_t *data, Callback &callback, std::index_sequence<I...>) {
+        callback(data[0], _value<dt>(data + OFFSETS[I])...);
+    }
+
+    template <typename vt>
+    static vt _value(const uint8_t *data) {
+        if constexpr (std::is_same<vt, int24_t>::value) {
+            int32_t v = (data[0] << 16) | (data[1] << 8) | data[2];
+            return int24_t(v & 0x800000 ? v | 0xFF000000 : v);
+        } else if constexpr (std::is_same<vt, float>::value) {
+            uint32_t u = _value<uint32_t>(data);
+            float ret;
+            memcpy(&ret, &u, sizeof(ret));
+            return ret;
+        } else {
+            typename std::make_unsigned<vt>::type u = 0;
+            for (size_t i = 0; i < sizeof(vt); i++) {
+                u = (u << 8) | data[i];
+            }
+            return static_cast<vt>(u);
+        }
+    }
+};
+
+}  // namespace Modbus
+
+#endif /* !__Modbus_Reply__ */
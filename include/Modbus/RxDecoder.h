@@ -0,0 +1,193 @@
+/*
+ * Decodes FPGA response FIFO words into Modbus frames.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Modbus_RxDecoder__
+#define __Modbus_RxDecoder__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <cRIO/FIFO.h>
+#include <Modbus/Parser.h>
+
+namespace Modbus {
+
+/**
+ * Frame decoded from the @glos{FPGA} response stream.
+ */
+struct RxFrame {
+    /**
+     * Offset of the first frame byte in the decoder arena.
+     */
+    size_t offset;
+
+    /**
+     * Number of bytes in the frame.
+     */
+    size_t length;
+
+    /**
+     * Timestamp when the frame reception started. Equals to the end
+     * timestamp of the previous frame, or the stream timestamp for the first
+     * frame.
+     */
+    uint64_t begin;
+
+    /**
+     * Timestamp when the frame was received. 0 if the frame wasn't followed
+     * by timestamp.
+     */
+    uint64_t end;
+};
+
+/**
+ * Decodes words read from the @glos{FPGA} response FIFO into Modbus frames.
+ * The stream starts with 4 words forming little endian 64 bit timestamp,
+ * followed by frames. Each frame consists of its data bytes (masked with
+ * FIFO::RX_MASK), optional FIFO::RX_ENDFRAME and 8 FIFO::RX_TIMESTAMP words
+ * forming little endian end timestamp.
+ *
+ * Frame bytes are stored in a preallocated arena, reused between decoded
+ * responses. The stream can be decoded in chunks, e.g. as elements are
+ * acquired from the FIFO. Runs of data words are decoded with SSE2 or NEON
+ * instructions if available, 8 words per step. decodeScalar provides
+ * reference implementation processing a word per step.
+ *
+ * @code{.cpp}
+ * Modbus::RxDecoder decoder;
+ * decoder.reset();
+ * decoder.decode(words, length);
+ * decoder.finish();
+ * for (size_t i = 0; i < decoder.frames(); i++) {
+ *     busList.parse(decoder.view(i));
+ * }
+ * @endcode
+ */
+class RxDecoder {
+public:
+    /**
+     * Constructs decoder.
+     *
+     * @param capacity initial arena capacity (in bytes)
+     */
+    RxDecoder(size_t capacity = 4096);
+
+    /**
+     * Prepares decoder for a new stream. Keeps allocated memory.
+     */
+    void reset();
+
+    /**
+     * Decodes part of the stream. Runs of data words are processed with SIMD
+     * instructions, if those are available.
+     *
+     * @param words response FIFO words
+     * @param length number of words
+     *
+     * @throw std::runtime_error on invalid word or repeated end timestamp
+     */
+    void decode(const uint16_t *words, size_t length);
+
+    /**
+     * Decodes part of the stream, one word at time. Reference implementation
+     * for decode.
+     *
+     * @param words response FIFO words
+     * @param length number of words
+     *
+     * @throw std::runtime_error on invalid word or repeated end timestamp
+     */
+    void decodeScalar(const uint16_t *words, size_t length);
+
+    /**
+     * Finishes the last frame. Shall be called after the whole stream was
+     * decoded.
+     */
+    void finish();
+
+    /**
+     * Returns number of decoded frames.
+     *
+     * @return number of frames
+     */
+    size_t frames() const { return _frames.size(); }
+
+    /**
+     * Returns decoded frame.
+     *
+     * @param index frame index
+     *
+     * @return frame record
+     */
+    const RxFrame &operator[](size_t index) const { return _frames[index]; }
+
+    /**
+     * Returns frame data.
+     *
+     * @param index frame index
+     *
+     * @return pointer to the first frame byte. Valid until next decode call
+     */
+    const uint8_t *data(size_t index) const { return _arena.data() + _frames[index].offset; }
+
+    /**
+     * Returns view of the frame, for parsing.
+     *
+     * @param index frame index
+     *
+     * @return parser view of the frame data
+     *
+     * @throw std::runtime_error if the frame is too short to be Modbus frame
+     */
+    ParserView view(size_t index) const { return ParserView(data(index), _frames[index].length); }
+
+    /**
+     * Returns stream timestamp (first 4 words of the stream).
+     *
+     * @return stream beginning timestamp
+     */
+    uint64_t beginTimestamp() const { return _streamTs; }
+
+private:
+    enum class State { HEADER, IDLE, DATA, TRAILER };
+
+    std::vector<uint8_t> _arena;
+    size_t _arenaLength;
+    std::vector<RxFrame> _frames;
+
+    State _state;
+    int _headerShift;
+    uint64_t _streamTs;
+    uint64_t _beginTs;
+    uint64_t _endTs;
+    int _endTsShift;
+
+    void _reserve(size_t length);
+    void _openFrame();
+    void _closeFrame();
+    void _decodeWord(uint16_t word);
+};
+
+}  // namespace Modbus
+
+#endif /* !__Modbus_RxDecoder__ */
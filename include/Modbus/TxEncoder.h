@@ -0,0 +1,148 @@
+/*
+ * Encodes Modbus frames into FPGA transmit FIFO words.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Modbus_TxEncoder__
+#define __Modbus_TxEncoder__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <cRIO/FIFO.h>
+#include <Modbus/Frame.h>
+
+namespace Modbus {
+
+/**
+ * Keeps stream of words written to the @glos{FPGA} command FIFO to transmit
+ * Modbus frames. Frames are encoded as they are added, so the stream is ready
+ * to be written to the FIFO without another pass over the data. The stream
+ * starts with header (transmit command, length, wait for trigger and
+ * timestamp), followed by encoded frames. Each frame is encoded as its bytes
+ * masked with FIFO::TX_MASK, FIFO::TX_FRAMEEND and wait for reply word. The
+ * stream is terminated with FIFO::TX_IRQTRIGGER and software trigger.
+ *
+ * Header and trailer are filled in seal(), as transmit command and software
+ * trigger are known only to the @glos{FPGA} class.
+ *
+ * @code{.cpp}
+ * Modbus::TxEncoder encoder;
+ * encoder.add(frame, 500);
+ * auto &words = encoder.seal(txCommand, softwareTrigger);
+ * fpga.writeCommandFIFO(words.data(), words.size(), 0);
+ * @endcode
+ */
+class TxEncoder {
+public:
+    TxEncoder();
+
+    /**
+     * Removes all encoded frames.
+     */
+    void reset();
+
+    /**
+     * Encodes frame at the end of the stream.
+     *
+     * @param frame Modbus frame to transmit
+     * @param timing maximal reply time in microseconds
+     */
+    void add(const Frame &frame, uint32_t timing);
+
+    /**
+     * Overwrites words of already encoded frame.
+     *
+     * @param frame index of the frame in the stream
+     * @param offset offset of the first byte in the frame
+     * @param data new frame data
+     * @param length data length
+     */
+    void patch(size_t frame, size_t offset, const uint8_t *data, size_t length) {
+        uint16_t *words = _words.data() + _offsets[frame] + offset;
+        for (size_t i = 0; i < length; i++) {
+            words[i] = LSST::cRIO::FIFO::TX_MASK | (static_cast<uint16_t>(data[i]) << 1);
+        }
+    }
+
+    /**
+     * Overwrites wait for reply word of already encoded frame.
+     *
+     * @param frame index of the frame in the stream
+     * @param timing new maximal reply time in microseconds
+     */
+    void setTiming(size_t frame, uint32_t timing) {
+        size_t end = frame + 1 < _offsets.size() ? _offsets[frame + 1]
+                                                  : _words.size() - (_sealed ? TRAILER_LENGTH : 0);
+        _words[end - 1] = waitWord(timing);
+    }
+
+    /**
+     * Fills stream header and appends trailer. Frames can be added after the
+     * stream was sealed - the stream shall be sealed again before being
+     * written to the FIFO.
+     *
+     * @param txCommand @glos{FPGA} command to transmit data on a bus
+     * @param trigger software trigger written after the stream
+     *
+     * @return words to write into the command FIFO
+     */
+    const std::vector<uint16_t> &seal(uint16_t txCommand, uint16_t trigger);
+
+    /**
+     * Returns number of encoded frames.
+     *
+     * @return number of frames encoded in the stream
+     */
+    size_t frames() const { return _offsets.size(); }
+
+    /**
+     * Returns word instructing @glos{FPGA} to wait for reply.
+     *
+     * @param timing maximal reply time in microseconds
+     *
+     * @return FIFO::TX_WAIT_RX or FIFO::TX_WAIT_LONG_RX (for timing over 4095
+     * microseconds, in milliseconds) word
+     */
+    static constexpr uint16_t waitWord(uint32_t timing) {
+        return timing > 0x0FFF ? ((0x0FFF & ((timing / 1000) + 1)) | LSST::cRIO::FIFO::TX_WAIT_LONG_RX)
+                               : (timing | LSST::cRIO::FIFO::TX_WAIT_RX);
+    }
+
+    /**
+     * Number of words in the stream header.
+     */
+    static constexpr size_t HEADER_LENGTH = 4;
+
+    /**
+     * Number of words in the stream trailer.
+     */
+    static constexpr size_t TRAILER_LENGTH = 2;
+
+private:
+    std::vector<uint16_t> _words;
+    std::vector<size_t> _offsets;
+    bool _sealed;
+};
+
+}  // namespace Modbus
+
+#endif /* !__Modbus_TxEncoder__ */
@@ -28,6 +28,7 @@
 #include <cRIO/Thread.h>
 #include <Modbus/Buffer.h>
 #include <Modbus/BusList.h>
+#include <Modbus/Frame.h>
 
 namespace Transports {
 
@@ -43,9 +44,9 @@ public:
      * @param address Expected @glos{ILC} address, for which response wasn't received
      * @param func Expected function which wasn't responded by the @glos{ILC}
      */
-    MissingResponse(const Modbus::Buffer& commanded)
-            : std::runtime_error(
-                      fmt::format("Missing response to command '{0}'", Modbus::hexDump(commanded))) {}
+    MissingResponse(const Modbus::Frame& commanded)
+            : std::runtime_error(fmt::format("Missing response to command '{0}'",
+                                             Modbus::hexDump(commanded.data(), commanded.size()))) {}
 };
 
 /**
@@ -132,7 +133,7 @@ public:
     virtual void telemetry(uint64_t& write_bytes, uint64_t& read_bytes) = 0;
 
 protected:
-    void execute_command(std::vector<uint8_t> command, Modbus::BusList& bus_list,
+    void execute_command(const Modbus::Frame& command, Modbus::BusList& bus_list,
                          std::chrono::time_point<std::chrono::steady_clock> end,
                          LSST::cRIO::Thread* calling_thread);
 };
@@ -161,6 +161,19 @@ public:
      */
     void addThread(Thread* thread, std::chrono::microseconds timeout = 50ms);
 
+    /**
+     * Sets thread attributes, adds thread to application threads and runs
+     * (starts) the thread.
+     *
+     * @param thread pointer to Thread to add
+     * @param attributes thread real-time attributes
+     * @param timeout thread starting timeout. Defaults to 50ms.
+     *
+     * @multithreading safe
+     */
+    void addThread(Thread* thread, const ThreadAttributes& attributes,
+                   std::chrono::microseconds timeout = 50ms);
+
     /**
      * Returns number of running threads.
      *
@@ -26,12 +26,15 @@
 #include <memory>
 
 #include <cRIO/FPGA.h>
+#include <cRIO/IngressQueue.h>
 #include <cRIO/InterruptHandler.h>
+#include <cRIO/InterruptRing.h>
 #include <cRIO/InterruptWatcherTask.h>
 #include <cRIO/Singleton.h>
 #include <cRIO/Task.h>
 #include <cRIO/TaskQueue.h>
 #include <cRIO/Thread.h>
+#include <cRIO/WorkerPool.h>
 
 namespace LSST {
 namespace cRIO {
@@ -50,18 +53,62 @@ public:
     ControllerThread(token);
     ~ControllerThread();
 
-    void startInterruptWatcherTask(FPGA* fpga);
+    /**
+     * Starts thread waiting for FPGA interrupts.
+     *
+     * @param fpga FPGA to wait for interrupts
+     * @param attributes interrupt watcher thread attributes
+     */
+    void startInterruptWatcherTask(FPGA* fpga, const ThreadAttributes& attributes = ThreadAttributes());
+
+    /**
+     * Stops thread waiting for FPGA interrupts. Shall be called before the
+     * FPGA passed to startInterruptWatcherTask is destroyed.
+     */
+    void stopInterruptWatcherTask();
 
     /* Add task into queue.
      *
      * @param task Task to enqueue.
+     *
+     * @return handle of the queued task, 0 if task wasn't queued
      */
-    void enqueue(std::shared_ptr<Task> task);
+    task_handle_t enqueue(std::shared_ptr<Task> task);
 
     /**
-     * Add task into queue to execute at the given time.
+     * Add task into queue to execute at the given time. Doesn't lock - task
+     * is pushed into lock-free ingress queue and the controller thread is
+     * woken up. The controller thread moves ingress tasks into its task queue
+     * before processing tasks, so enqueue_at doesn't contend with running
+     * tasks.
+     *
+     * @param task task to enqueue
+     * @param when time to execute the task
+     *
+     * @return handle of the queued task, 0 if task validation failed. The
+     * handle remains valid while the task is rescheduled
      */
-    void enqueue_at(std::shared_ptr<Task> task, std::chrono::steady_clock::time_point when);
+    task_handle_t enqueue_at(std::shared_ptr<Task> task, std::chrono::steady_clock::time_point when);
+
+    /**
+     * Removes queued task. Runs in O(log n). Task being executed isn't
+     * rescheduled if canceled.
+     *
+     * @param handle task handle, returned from enqueue or enqueue_at
+     *
+     * @return true if task was removed, false if it isn't queued
+     */
+    bool cancel(task_handle_t handle);
+
+    /**
+     * Changes time when the queued task shall be executed. Runs in O(log n).
+     *
+     * @param handle task handle, returned from enqueue or enqueue_at
+     * @param when new execution time
+     *
+     * @return true if task was rescheduled, false if it isn't queued
+     */
+    bool reschedule(task_handle_t handle, std::chrono::steady_clock::time_point when);
 
     /**
      * Remove task from queue. All copies of the tasks will be removed.
@@ -78,7 +125,33 @@ public:
     /**
      * Return numer of tasks in the queue.
      */
-    size_t size() { return _task_queue.size(); }
+    size_t size();
+
+    /**
+     * Sets number of worker threads running tasks. With 0 workers (the
+     * default) tasks are run in the controller thread, one at a time. With
+     * workers, the controller thread dispatches due tasks into a worker
+     * pool. Tasks with the same Task::serializationKey are still run one at
+     * a time, in order they are due. Tasks with different keys can run in
+     * parallel. Interrupt handlers are run in the pool by a signal job with
+     * Task::CONTROLLER_KEY, so they don't run in parallel with tasks with the
+     * default key, and dispatching interrupts doesn't allocate.
+     *
+     * Running task remains in the queue until it finishes, and is then
+     * rescheduled or removed. Tasks running in the current pool finish
+     * before the call returns.
+     *
+     * @param workers number of worker threads, 0 to run tasks in the
+     * controller thread
+     */
+    void setWorkers(size_t workers);
+
+    /**
+     * Returns number of worker threads.
+     *
+     * @return number of workers, 0 if tasks are run in the controller thread
+     */
+    size_t getWorkers();
 
     /**
      * Sets interrupt handler.
@@ -94,13 +167,37 @@ public:
 
     void checkInterrupts(uint32_t triggeredIterrupts);
 
+    /**
+     * Passes triggered interrupts to the controller thread. Doesn't allocate
+     * or lock - mask is queued into interrupt ring and the controller thread
+     * is woken up. The controller thread drains the ring before processing
+     * tasks, and calls interrupt handlers with OR of all queued masks (or
+     * signals the worker pool, if workers are set).
+     * Shall be called only from a single thread (the interrupt watcher).
+     *
+     * @param triggeredInterrupts triggered interrupts mask
+     */
+    void signalInterrupts(uint32_t triggeredInterrupts);
+
 protected:
     void run(std::unique_lock<std::mutex>& lock) override;
 
+    void wakeUp() override { _ingress.signal.notify(); }
+
 private:
+    void _drain_ingress();
+    void _dispatch_interrupts();
     void _process_tasks();
+    task_return_t _run_task(std::shared_ptr<Task> task);
+    void _finish_task(std::shared_ptr<Task> task, task_handle_t handle,
+                      std::chrono::steady_clock::time_point deadline, task_return_t wait);
 
     TaskQueue _task_queue;
+    IngressQueue<TaskEntry> _ingress;
+    InterruptRing _interrupt_ring;
+    std::unique_ptr<WorkerPool> _worker_pool;
+    // interrupts ORed until handled by the worker pool signal job
+    std::atomic<uint32_t> _pending_interrupts = 0;
 
     std::atomic<bool> _exit_requested = false;
 
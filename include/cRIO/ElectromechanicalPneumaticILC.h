@@ -23,6 +23,7 @@
 #ifndef _cRIO_ElectromechanicalPneumaticILC_h
 #define _cRIO_ElectromechanicalPneumaticILC_h
 
+#include <ILC/BroadcastCoalescer.h>
 #include <ILC/ILCBusList.h>
 #include <Modbus/Buffer.h>
 
@@ -99,10 +100,35 @@ public:
      * @ingroup M1M3_hp
      * @ingroup M2
      */
-    void broadcastStepperSteps(uint8_t counter, std::vector<int8_t> steps) {
+    void broadcastStepperSteps(uint8_t counter, const std::vector<int8_t> &steps) {
         broadcastFunction(EA_BROADCAST, ILC_EM_CMD::SET_STEPPER_STEPS, 1800, counter, steps);
     }
 
+    /**
+     * Returns coalescer for stepper steps. Steps set with
+     * coalescer.set(address, steps) are send as a single broadcast (as
+     * broadcastStepperSteps does) when at least threshold ILCs are commanded
+     * in a cycle, otherwise as setStepperSteps unicasts.
+     *
+     * Broadcast returns no status - processStepperForceStatus isn't called
+     * for ILCs commanded in a broadcast cycle, and the broadcast resends last
+     * known steps of ILCs not commanded in the cycle.
+     *
+     * @param addresses stepper ILC addresses, in broadcast payload order
+     * @param threshold minimal number of ILCs commanded in cycle to use
+     * broadcast. 0 for majority of the addresses
+     *
+     * @return stepper steps coalescer
+     *
+     * @ingroup M1M3_hp
+     * @ingroup M2
+     */
+    static ILC::BroadcastCoalescer stepperStepsCoalescer(const std::vector<uint8_t> &addresses,
+                                                         size_t threshold = 0) {
+        return ILC::BroadcastCoalescer(ILC_EM_CMD::SET_STEPPER_STEPS, 1800, EA_BROADCAST, 1800, addresses, 1,
+                                       threshold == 0 ? addresses.size() / 2 + 1 : threshold);
+    }
+
     /**
      * Unicast Stepper motor @glos{ILC} Force [N] and Status Request. @glos{ILC} command
      * code 67 (0x43). Applies for M2 tangent and axials controllers, as well
@@ -0,0 +1,53 @@
+/*
+ * FPGA FIFO commands and masks.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CRIO_FIFO_H_
+#define CRIO_FIFO_H_
+
+#include <cstdint>
+
+namespace LSST {
+namespace cRIO {
+
+namespace FIFO {
+// masks for FPGA FIFO commands
+const static uint16_t WRITE = 0x1000;
+const static uint16_t TX_FRAMEEND = 0x20DA;
+const static uint16_t TX_TIMESTAMP = 0x3000;
+const static uint16_t DELAY = 0x4000;
+const static uint16_t LONG_DELAY = 0x5000;
+const static uint16_t TX_WAIT_RX = 0x6000;
+const static uint16_t TX_IRQTRIGGER = 0x7000;
+const static uint16_t TX_WAIT_TRIGGER = 0x8000;
+const static uint16_t TX_WAIT_LONG_RX = 0x9000;
+const static uint16_t RX_ENDFRAME = 0xA000;
+const static uint16_t RX_TIMESTAMP = 0xB000;
+const static uint16_t CMD_MASK = 0xF000;
+
+const static uint16_t TX_MASK = 0x1200;
+const static uint16_t RX_MASK = 0x9200;
+}  // namespace FIFO
+
+}  // namespace cRIO
+}  // namespace LSST
+
+#endif  // !CRIO_FIFO_H_
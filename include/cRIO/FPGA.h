@@ -26,9 +26,12 @@
 #include <chrono>
 #include <stddef.h>
 #include <stdint.h>
+#include <vector>
 
+#include <cRIO/FrameTiming.h>
 #include <cRIO/SimpleFPGA.h>
 #include <ILC/ILCBusList.h>
+#include <Modbus/RxDecoder.h>
 
 using namespace std::chrono_literals;
 
@@ -51,6 +54,36 @@ enum MPUCommands {
     RESET = 255,
 };
 
+class FPGA;
+
+/**
+ * Handle of @glos{ILC} commands submitted to the @glos{FPGA}. Returned by
+ * FPGA::ilcSubmit, shall be passed to FPGA::ilcCollect to wait for and parse
+ * the responses.
+ */
+class ILCSubmission {
+public:
+    /**
+     * Construct handle with no commands submitted.
+     */
+    ILCSubmission() : _ilc(nullptr), _irq(0) {}
+
+    /**
+     * Returns true if submitted commands weren't yet collected.
+     *
+     * @return true if commands are in flight
+     */
+    bool pending() const { return _ilc != nullptr; }
+
+private:
+    friend class FPGA;
+
+    ILCSubmission(ILC::ILCBusList* ilc, uint32_t irq) : _ilc(ilc), _irq(irq) {}
+
+    ILC::ILCBusList* _ilc;
+    uint32_t _irq;
+};
+
 /**
  * Interface class for cRIO FPGA. Subclasses can talk either to the real HW, or
  * be a software simulator.
@@ -112,6 +145,61 @@ public:
      */
     virtual void ilcCommands(ILC::ILCBusList& ilc, int32_t timeout);
 
+    /**
+     * Writes ILC commands to the command FIFO and returns without waiting for
+     * the responses. The calling code can prepare next commands (in a
+     * different ILC::ILCBusList, see ILC::DoubleBufferedBusList) while the
+     * commands are processed, and then call ilcCollect to process the
+     * responses. The bus list shall not be modified until the commands are
+     * collected.
+     *
+     * @param ilc ILC with commands. Its ILC::getBus() method returns bus used
+     * for communication.
+     *
+     * @return handle to pass to ilcCollect
+     *
+     * @throw std::runtime_error when commands submitted on the same bus weren't
+     * yet collected
+     *
+     * @code{.cpp}
+     * auto submission = fpga.ilcSubmit(ilcs.front());
+     * prepareNextCycle(ilcs.back());
+     * fpga.ilcCollect(submission, 100);
+     * ilcs.swap();
+     * @endcode
+     */
+    ILCSubmission ilcSubmit(ILC::ILCBusList& ilc);
+
+    /**
+     * Waits for the submitted commands to finish and process the responses.
+     * Does nothing if the submission isn't pending.
+     *
+     * @param submission handle returned by ilcSubmit. Reset to not pending.
+     * @param timeout timeout in milliseconds
+     */
+    void ilcCollect(ILCSubmission& submission, int32_t timeout);
+
+    /**
+     * Send commands to multiple busses in parallel. Commands for all busses
+     * are written first, then the method waits for any of the busses IRQs
+     * and process bus responses as its IRQ is triggered. Total communication
+     * time is then the time of the slowest bus, not the sum of all busses
+     * times.
+     *
+     * Empty bus lists are skipped. If response processing on a bus fails,
+     * responses on other busses are processed and the first exception is
+     * rethrown afterwards.
+     *
+     * @param ilcs ILCs to send commands to. Each shall communicate on
+     * different bus (ILC::ILCBusList::getBus()).
+     * @param timeout timeout in milliseconds for all busses
+     *
+     * @throw std::runtime_error when two ILCs communicate on the same bus
+     *
+     * @see ilcCommands(ILC::ILCBusList&, int32_t)
+     */
+    virtual void ilcCommands(std::vector<ILC::ILCBusList*> ilcs, int32_t timeout);
+
     /**
      * Writes buffer to command FIFO. Command FIFO is processed in
      * CommandMultiplexer Vi.
@@ -129,6 +217,20 @@ public:
      */
     virtual void writeCommandFIFO(uint16_t* data, size_t length, uint32_t timeout) = 0;
 
+    /**
+     * Writes constant data to command FIFO. Implementations only read the
+     * data, so the call is forwarded to writeCommandFIFO(uint16_t*, size_t, uint32_t).
+     *
+     * @param data buffer to write to FIFO
+     * @param length lenght of the data buffer
+     * @param timeout timeout for write operation
+     *
+     * @throw NiError on NI error
+     */
+    void writeCommandFIFO(const uint16_t* data, size_t length, uint32_t timeout) {
+        writeCommandFIFO(const_cast<uint16_t*>(data), length, timeout);
+    }
+
     void writeCommandFIFO(uint16_t data, uint32_t timeout) { writeCommandFIFO(&data, 1, timeout); }
 
     /**
@@ -149,6 +251,20 @@ public:
      */
     virtual void writeRequestFIFO(uint16_t* data, size_t length, uint32_t timeout) = 0;
 
+    /**
+     * Writes constant data to request FIFO. Implementations only read the
+     * data, so the call is forwarded to writeRequestFIFO(uint16_t*, size_t, uint32_t).
+     *
+     * @param data request command followed by request parameters
+     * @param length length of data buffer
+     * @param timeout timeout for write operation
+     *
+     * @throw NiError on NI error
+     */
+    void writeRequestFIFO(const uint16_t* data, size_t length, uint32_t timeout) {
+        writeRequestFIFO(const_cast<uint16_t*>(data), length, timeout);
+    }
+
     /**
      * Write single command into requestFIFO.
      *
@@ -169,6 +285,38 @@ public:
      */
     virtual void readU16ResponseFIFO(uint16_t* data, size_t length, uint32_t timeout) = 0;
 
+    /**
+     * Acquires elements of the response FIFO for in-place reading. Acquired
+     * elements shall be released with releaseU16ResponseFIFO once processed.
+     * Number of acquired elements can be smaller than requested length (e.g.
+     * when NiFpga_AcquireFifoReadElementsU16 wraps around the end of DMA
+     * buffer), caller shall then acquire the rest with another call.
+     *
+     * Default implementation copies data with readU16ResponseFIFO into an
+     * internal buffer. Hardware implementations shall override it with
+     * NiFpga_AcquireFifoReadElementsU16 and NiFpga_ReleaseFifoElements calls
+     * to avoid copying.
+     *
+     * @param length number of elements to acquire
+     * @param timeout timeout in milliseconds
+     * @param acquired returns number of acquired elements
+     *
+     * @return pointer to the first acquired element. Valid until
+     * releaseU16ResponseFIFO is called
+     *
+     * @throw NiError on NI error
+     */
+    virtual const uint16_t* acquireU16ResponseFIFO(size_t length, uint32_t timeout, size_t& acquired);
+
+    /**
+     * Releases response FIFO elements acquired by acquireU16ResponseFIFO.
+     *
+     * @param elements number of elements to release
+     *
+     * @throw NiError on NI error
+     */
+    virtual void releaseU16ResponseFIFO(size_t elements) {}
+
     /**
      * Wait for given IRQs.
      *
@@ -189,16 +337,37 @@ public:
      */
     virtual void ackIrqs(uint32_t irqs) = 0;
 
+    /**
+     * Returns recorder of received frames timing. Frames received by
+     * ilcCommands and ilcCollect are recorded, together with the bus
+     * transmission start timestamp.
+     *
+     * @return frame timing recorder
+     */
+    FrameTimingRecorder& timingRecorder() { return _timingRecorder; }
+
 protected:
     /**
-     * Called when full 64 bit timestamp is received.
+     * Called for each received frame, after the frame was recorded in
+     * timingRecorder.
      *
-     * @param timestamp received timestamp
+     * @param begin previous frame end (or transmission start) timestamp
+     * @param end frame end timestamp
      */
     virtual void reportTime(uint64_t begin, uint64_t end) {}
 
 private:
     uint16_t _modbusSoftwareTrigger;
+
+    uint32_t _submittedIrqs;
+
+    std::vector<uint16_t> _responseCopy;
+    Modbus::RxDecoder _rxDecoder;
+    FrameTimingRecorder _timingRecorder;
+
+    void _checkSubmitted(uint32_t irq, uint8_t bus);
+    void _writeILCCommands(ILC::ILCBusList& ilc);
+    void _readILCResponses(ILC::ILCBusList& ilc);
 };
 
 }  // namespace cRIO
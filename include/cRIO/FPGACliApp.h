@@ -61,6 +61,7 @@ public:
 
     int setIlcTimeout(command_vec cmds);
     int programILC(command_vec cmds);
+    int timing(command_vec cmds);
 
 protected:
     void addILCCommand(const char* command, std::function<void(ILCUnit)> action, const char* help);
@@ -88,17 +89,16 @@ protected:
     }
 
     /**
-     * Run prepared @glos{ILC} commands on @glos{ILC} busses.
+     * Run prepared @glos{ILC} commands on @glos{ILC} busses. As multiple CLI
+     * @glos{ILC}s can share a bus, @glos{ILC}s are grouped into rounds with
+     * at most one @glos{ILC} per bus. Busses in a round are processed in
+     * parallel, rounds one after the other.
      *
      * @param timeout @glos{ILC} timeout (in ms)
+     *
+     * @see FPGA::ilcCommands(std::vector<ILC::ILCBusList*>, int32_t)
      */
-    void runILCCommands(int32_t timeout) {
-        for (auto ilcp : _ilcs) {
-            if (ilcp->empty() == false) {
-                getFPGA()->ilcCommands(*ilcp, timeout);
-            }
-        }
-    }
+    void runILCCommands(int32_t timeout);
 
     /**
      * Disable given ILC.
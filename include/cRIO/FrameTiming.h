@@ -0,0 +1,199 @@
+/*
+ * Records timing of Modbus frames received by FPGA.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CRIO_FRAMETIMING_H_
+#define CRIO_FRAMETIMING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include <Modbus/ByteMap.h>
+
+namespace LSST {
+namespace cRIO {
+
+/**
+ * Timing of a single received frame. Timestamps are @glos{FPGA} timestamps.
+ */
+struct FrameTiming {
+    uint8_t bus;      ///< Modbus bus
+    uint8_t address;  ///< ILC address
+    uint8_t func;     ///< function code
+    uint64_t begin;   ///< end of the previous frame (or start of the transmission)
+    uint64_t end;     ///< frame received, 0 if the frame wasn't terminated with timestamp
+
+    /**
+     * Returns frame duration.
+     *
+     * @return time between begin and end, 0 if end isn't known
+     */
+    uint64_t duration() const { return end > begin ? end - begin : 0; }
+};
+
+/**
+ * Response latency (FrameTiming::duration) statistics of an @glos{ILC}
+ * address, calculated over recent frames.
+ */
+struct LatencyStatistics {
+    uint8_t bus;      ///< Modbus bus
+    uint8_t address;  ///< ILC address
+    size_t samples;   ///< number of frames the statistics was calculated from
+    uint64_t min;     ///< minimal latency
+    double mean;      ///< mean latency
+    uint64_t p99;     ///< 99th percentile
+    uint64_t max;     ///< maximal latency
+};
+
+/**
+ * Bus occupancy. Calculated as ratio of time between start of the
+ * transmission and the last received frame to time between two consecutive
+ * transmissions on the bus. Known after the next transmission starts.
+ */
+struct BusOccupancy {
+    uint8_t bus;      ///< Modbus bus
+    uint64_t cycles;  ///< number of recorded cycles
+    uint64_t busy;    ///< time the bus was busy in the last cycle
+    uint64_t period;  ///< time between the last two cycles starts, 0 if unknown
+    double last;      ///< occupancy of the last cycle (0-1)
+    double max;       ///< maximal recorded occupancy
+};
+
+/**
+ * Snapshot of the recorded timing.
+ */
+struct TimingSnapshot {
+    std::vector<FrameTiming> frames;           ///< recent frames, ordered by bus and time
+    std::vector<LatencyStatistics> latencies;  ///< per ILC latencies, ordered by bus and address
+    std::vector<BusOccupancy> busses;          ///< bus occupancies
+
+    friend std::ostream& operator<<(std::ostream& os, const TimingSnapshot& snapshot);
+};
+
+/**
+ * Records received frames timing. Keeps fixed size ring of recent frames for
+ * each bus, rolling window of response latencies for each @glos{ILC} and
+ * bus occupancy. Memory is allocated when a bus or address is recorded for
+ * the first time. Recording and snapshot can be called from different
+ * threads.
+ *
+ * @code{.cpp}
+ * auto snapshot = fpga.timingRecorder().snapshot();
+ * for (auto& l : snapshot.latencies) {
+ *     std::cout << int(l.address) << " " << l.p99 << std::endl;
+ * }
+ * @endcode
+ */
+class FrameTimingRecorder {
+public:
+    /**
+     * Construct recorder.
+     *
+     * @param frames number of recent frames kept for each bus
+     * @param window number of latency samples kept for each ILC
+     */
+    FrameTimingRecorder(size_t frames = 256, size_t window = 100);
+
+    /**
+     * Enables or disables recording.
+     *
+     * @param enabled new recording state
+     */
+    void setEnabled(bool enabled) { _enabled = enabled; }
+
+    bool enabled() const { return _enabled; }
+
+    /**
+     * Records start of the bus transmission.
+     *
+     * @param bus Modbus bus
+     * @param begin transmission timestamp
+     */
+    void startCycle(uint8_t bus, uint64_t begin);
+
+    /**
+     * Records received frame.
+     *
+     * @param bus Modbus bus
+     * @param address ILC address
+     * @param func function code
+     * @param begin previous frame end timestamp
+     * @param end frame received timestamp
+     * @param latency when false, the frame doesn't directly follow response
+     * of the previous command (responses were missing or broadcast was
+     * sent) and isn't included in the latency statistics. Frames without
+     * known end (end <= begin) are never included
+     */
+    void record(uint8_t bus, uint8_t address, uint8_t func, uint64_t begin, uint64_t end,
+                bool latency = true);
+
+    /**
+     * Returns copy of recorded values with calculated statistics.
+     *
+     * @return recorder snapshot
+     */
+    TimingSnapshot snapshot() const;
+
+    /**
+     * Clears recorded values.
+     */
+    void clear();
+
+private:
+    struct Window {
+        std::vector<uint64_t> samples;
+        size_t next = 0;
+        size_t count = 0;
+    };
+
+    struct Bus {
+        std::vector<FrameTiming> frames;
+        size_t next = 0;
+        size_t count = 0;
+
+        Modbus::ByteMap<Window> latencies;
+
+        uint64_t cycles = 0;
+        uint64_t cycleBegin = 0;
+        uint64_t lastEnd = 0;
+        uint64_t busy = 0;
+        uint64_t period = 0;
+        double last = 0;
+        double max = 0;
+    };
+
+    size_t _frames;
+    size_t _window;
+    std::atomic<bool> _enabled;
+
+    std::map<uint8_t, Bus> _busses;
+    mutable std::mutex _mutex;
+};
+
+}  // namespace cRIO
+}  // namespace LSST
+
+#endif  //! CRIO_FRAMETIMING_H_
@@ -0,0 +1,169 @@
+/*
+ * Lock-free multiple producers, single consumer queue.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __cRIO_IngressQueue__
+#define __cRIO_IngressQueue__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace LSST {
+namespace cRIO {
+
+/**
+ * Wake-up signal for a single waiting thread. Signal holds sequence number,
+ * incremented by every notify call. Waiting thread reads the sequence,
+ * checks its work, and then waits for the sequence to change. As the wait
+ * returns immediately if the sequence was changed after it was read, no
+ * notification is lost - no mutex is needed to guard the checked condition.
+ *
+ * Implemented with Linux futex, so notify doesn't take any lock.
+ */
+class WakeSignal {
+public:
+    /**
+     * Returns current sequence number. Shall be read before the waiting
+     * thread checks for work.
+     *
+     * @return sequence number to pass to wait
+     */
+    uint32_t sequence() const { return _sequence.load(std::memory_order_acquire); }
+
+    /**
+     * Increments sequence and wakes up waiting thread.
+     */
+    void notify();
+
+    /**
+     * Waits for sequence change.
+     *
+     * @param sequence sequence number read before work was checked
+     */
+    void wait(uint32_t sequence);
+
+    /**
+     * Waits for sequence change or the given time.
+     *
+     * @param sequence sequence number read before work was checked
+     * @param abs_time time to wait until
+     */
+    void wait_until(uint32_t sequence, std::chrono::steady_clock::time_point abs_time);
+
+private:
+    std::atomic<uint32_t> _sequence = 0;
+    std::atomic<uint32_t> _waiting = 0;
+};
+
+/**
+ * Lock-free multiple producers, single consumer queue. Producers push values
+ * with a single compare and swap, never blocking on consumer or other
+ * producers. Consumer drains all queued values at once, in the order they
+ * were pushed. Only a single thread can drain the queue at the same time.
+ *
+ * @tparam T queued values type
+ */
+template <typename T>
+class IngressQueue {
+public:
+    IngressQueue() {}
+    IngressQueue(const IngressQueue&) = delete;
+    IngressQueue& operator=(const IngressQueue&) = delete;
+
+    ~IngressQueue() {
+        drain([](T&&) {});
+    }
+
+    /**
+     * Pushes value into queue and wakes up consumer.
+     *
+     * @param value value to push
+     */
+    void push(T value) {
+        Node* node = new Node{std::move(value), _head.load(std::memory_order_relaxed)};
+        while (_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                           std::memory_order_relaxed) == false) {
+        }
+        signal.notify();
+    }
+
+    /**
+     * Removes all queued values, calling action for each in the push order.
+     * Shall be called only from a single (consumer) thread at a time.
+     *
+     * @param action action called for each value
+     *
+     * @return number of drained values
+     */
+    template <typename Action>
+    size_t drain(Action&& action) {
+        Node* node = _head.exchange(nullptr, std::memory_order_acquire);
+        if (node == nullptr) {
+            return 0;
+        }
+
+        // nodes are linked from the last pushed
+        Node* fifo = nullptr;
+        while (node != nullptr) {
+            Node* next = node->next;
+            node->next = fifo;
+            fifo = node;
+            node = next;
+        }
+
+        size_t ret = 0;
+        while (fifo != nullptr) {
+            Node* next = fifo->next;
+            action(std::move(fifo->value));
+            delete fifo;
+            fifo = next;
+            ret++;
+        }
+        return ret;
+    }
+
+    /**
+     * Returns true if queue is empty.
+     *
+     * @return true if no value is queued
+     */
+    bool empty() const { return _head.load(std::memory_order_acquire) == nullptr; }
+
+    /**
+     * Signal notified on every push. Consumer can wait on it for new values.
+     */
+    WakeSignal signal;
+
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> _head = nullptr;
+};
+
+}  // namespace cRIO
+}  // namespace LSST
+
+#endif /* !__cRIO_IngressQueue__ */
@@ -0,0 +1,87 @@
+/*
+ * Lock-free ring of triggered interrupt masks.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __cRIO_InterruptRing__
+#define __cRIO_InterruptRing__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace LSST {
+namespace cRIO {
+
+/**
+ * Pre-allocated lock-free ring of triggered interrupt masks. Passes
+ * interrupts from a single producer (InterruptWatcherThread) to a single
+ * consumer (ControllerThread) without allocation or locking.
+ *
+ * Consumer drains all queued masks at once, OR-ing them together - burst of
+ * interrupts is handled in a single dispatch. If the ring is full (consumer
+ * isn't running), masks are OR-ed into overflow mask, so no interrupt is
+ * lost.
+ */
+class InterruptRing {
+public:
+    InterruptRing() {}
+    InterruptRing(const InterruptRing&) = delete;
+    InterruptRing& operator=(const InterruptRing&) = delete;
+
+    /**
+     * Queues triggered interrupts. Shall be called only from a single thread.
+     *
+     * @param mask triggered interrupts mask
+     *
+     * @return false if ring is full and mask was coalesced into overflow
+     */
+    bool push(uint32_t mask);
+
+    /**
+     * Removes all queued masks. Shall be called only from a single thread.
+     *
+     * @return OR of all queued masks, 0 if nothing was queued
+     */
+    uint32_t drain();
+
+    /**
+     * Returns true if no interrupt is queued.
+     *
+     * @return true if ring and overflow are empty
+     */
+    bool empty() const;
+
+    static constexpr size_t CAPACITY = 64;
+
+private:
+    std::array<uint32_t, CAPACITY> _masks;
+
+    // producer and consumer indices are on separate cache lines
+    alignas(64) std::atomic<size_t> _tail = 0;
+    alignas(64) std::atomic<size_t> _head = 0;
+    std::atomic<uint32_t> _overflow = 0;
+};
+
+}  // namespace cRIO
+}  // namespace LSST
+
+#endif /* !__cRIO_InterruptRing__ */
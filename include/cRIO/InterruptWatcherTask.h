@@ -34,7 +34,10 @@ namespace cRIO {
 
 class InterruptWatcherThread : public Thread {
 public:
-    InterruptWatcherThread(FPGA* fpga) : _fpga(fpga) {}
+    InterruptWatcherThread(FPGA* fpga, const ThreadAttributes& attributes = ThreadAttributes())
+            : _fpga(fpga) {
+        setAttributes(attributes);
+    }
     ~InterruptWatcherThread() { stop(std::chrono::seconds(2)); }
 
 protected:
@@ -48,8 +51,10 @@ private:
 class InterruptWatcherTask : public Task {
 public:
     /**
-     * Construct a task for handling incoming interrupts. When interrupt is
-     * received, the task is queued into ControllerThread and run.
+     * Construct a task for handling incoming interrupts. Runs interrupt
+     * handlers when run in ControllerThread. InterruptWatcherThread passes
+     * interrupts directly through ControllerThread::signalInterrupts, the
+     * task can be used to trigger handlers from other tasks.
      *
      * @param triggeredIterrupts
      */
@@ -32,6 +32,10 @@
 
 #include <arpa/inet.h>
 
+#include <Modbus/ByteMap.h>
+#include <Modbus/CRC.h>
+#include <cRIO/FIFO.h>
+
 #ifdef __APPLE__
 
 #include <libkern/OSByteOrder.h>
@@ -62,25 +66,6 @@
 namespace LSST {
 namespace cRIO {
 
-namespace FIFO {
-// masks for FPGA FIFO commands
-const static uint16_t WRITE = 0x1000;
-const static uint16_t TX_FRAMEEND = 0x20DA;
-const static uint16_t TX_TIMESTAMP = 0x3000;
-const static uint16_t DELAY = 0x4000;
-const static uint16_t LONG_DELAY = 0x5000;
-const static uint16_t TX_WAIT_RX = 0x6000;
-const static uint16_t TX_IRQTRIGGER = 0x7000;
-const static uint16_t TX_WAIT_TRIGGER = 0x8000;
-const static uint16_t TX_WAIT_LONG_RX = 0x9000;
-const static uint16_t RX_ENDFRAME = 0xA000;
-const static uint16_t RX_TIMESTAMP = 0xB000;
-const static uint16_t CMD_MASK = 0xF000;
-
-const static uint16_t TX_MASK = 0x1200;
-const static uint16_t RX_MASK = 0x9200;
-}  // namespace FIFO
-
 /**
  * 24 bit type integer. This is used to pass some parameters to ILC calls.
  */
@@ -437,61 +422,11 @@ public:
     };
 
     /**
-     * Class to calculate CRC. Example usage:
-     *
-     * @code{.cpp}
-     * ModbusBuffer::CRC crc{};
+     * Class to calculate CRC. Shares implementation with Modbus::CRC.
      *
-     * for (uint8_t d = 0; d < 0xFF; d++) {
-     *     crc.add(d);
-     * }
-     * std::cout << "Modbus CRC is " << crc.get() << "(0x" << << std::setw(4) << std::setfill('0')
-     *     << std::hex << crc.get() << ")" << std::endl;
-     * @endcode
+     * @see Modbus::CRC
      */
-    class CRC {
-    public:
-        /**
-         * Construct CRC class. The class is ready to accept add calls (reset
-         * don't need to be called).
-         */
-        CRC() { reset(); }
-
-        /**
-         * Construct CRC class and fill its buffer.
-         *
-         * @param buf data buffer
-         * @param len data length
-         */
-        CRC(uint8_t* data, size_t len) {
-            reset();
-            for (size_t i = 0; i < len; i++) {
-                add(data[i]);
-            }
-        }
-
-        /**
-         * Reset internal CRC counter.
-         */
-        void reset() { _crcCounter = 0xFFFF; }
-
-        /**
-         * Adds data to CRC buffer. Updates CRC value to match previous data.
-         *
-         * @param data data to be added
-         */
-        void add(uint8_t data);
-
-        /**
-         * Returns CRC value.
-         *
-         * @return buffer Modbus CRC
-         */
-        uint16_t get() { return _crcCounter; }
-
-    private:
-        uint16_t _crcCounter;
-    };
+    using CRC = Modbus::CRC;
 
     /**
      * Thrown when ModBus error response is received.
@@ -683,8 +618,8 @@ private:
     bool _recordChanges;
     std::vector<uint8_t> _records;
 
-    std::map<uint8_t, std::function<void(uint8_t)>> _actions;
-    std::map<uint8_t, std::pair<uint8_t, std::function<void(uint8_t, uint8_t)>>> _errorActions;
+    Modbus::ByteMap<std::function<void(uint8_t)>> _actions;
+    Modbus::ByteMap<std::pair<uint8_t, std::function<void(uint8_t, uint8_t)>>> _errorActions;
 };
 
 template <>
@@ -0,0 +1,155 @@
+/*
+ * Periodic task scheduled against its deadlines.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __cRIO_PeriodicTask__
+#define __cRIO_PeriodicTask__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <cRIO/Task.h>
+
+namespace LSST {
+namespace cRIO {
+
+/**
+ * Task run with a fixed period. Unlike tasks returning wait time from run,
+ * the next activation is scheduled against the previous deadline (next =
+ * deadline + period), so execution time of the task doesn't accumulate as
+ * drift. Period has microsecond resolution.
+ *
+ * If an activation ends past the next deadline, the missed periods are
+ * handled according to the policy - either skipped, with the next
+ * activation aligned to the period grid, or run back to back until the
+ * task catches up. Lateness (time between deadline and start of the
+ * activation) is recorded for each activation.
+ *
+ * @code{.cpp}
+ * class ForceLoop : public LSST::cRIO::PeriodicTask {
+ * public:
+ *     ForceLoop() : PeriodicTask(20ms) {}
+ *     bool runPeriod() override { applyForces(); return true; }
+ * };
+ *
+ * ControllerThread::instance().enqueue_at(std::make_shared<ForceLoop>(), nextTrigger);
+ * @endcode
+ */
+class PeriodicTask : public Task {
+public:
+    /**
+     * Policy for periods missed because the task run too late or too long.
+     */
+    enum class MissedPolicy {
+        SKIP,     ///< skip missed periods, next activation on the next deadline in the future
+        CATCH_UP  ///< run all missed activations as soon as possible
+    };
+
+    /**
+     * Constructs periodic task.
+     *
+     * @param period task period
+     * @param policy what to do with missed periods
+     */
+    PeriodicTask(std::chrono::microseconds period, MissedPolicy policy = MissedPolicy::SKIP);
+
+    /**
+     * Records activation start and calls runPeriod.
+     *
+     * @return 0 to reschedule the task, DONT_RESCHEDULE if runPeriod
+     * returned false
+     */
+    task_return_t run() final;
+
+    /**
+     * Called on each activation.
+     *
+     * @return false if the task shall not be run anymore
+     */
+    virtual bool runPeriod() = 0;
+
+    /**
+     * Records activation lateness and computes the next deadline.
+     *
+     * @param deadline deadline of the finished activation
+     * @param now time the activation finished
+     * @param wait ignored
+     *
+     * @return next deadline
+     */
+    std::chrono::steady_clock::time_point nextRun(std::chrono::steady_clock::time_point deadline,
+                                                  std::chrono::steady_clock::time_point now,
+                                                  task_return_t wait) override;
+
+    std::chrono::microseconds getPeriod() const { return _period; }
+
+    MissedPolicy getPolicy() const { return _policy; }
+
+    /**
+     * Returns lateness of the last activation.
+     *
+     * @return time between the last deadline and start of its activation
+     */
+    std::chrono::nanoseconds lastLateness() const { return std::chrono::nanoseconds(_lastLateness); }
+
+    /**
+     * Returns maximal lateness since construction or the last resetStatistics call.
+     *
+     * @return maximal recorded lateness
+     */
+    std::chrono::nanoseconds maxLateness() const { return std::chrono::nanoseconds(_maxLateness); }
+
+    /**
+     * Returns number of activations.
+     *
+     * @return activations counter
+     */
+    uint64_t activations() const { return _activations; }
+
+    /**
+     * Returns number of periods skipped. Always 0 for the CATCH_UP policy.
+     *
+     * @return skipped periods counter
+     */
+    uint64_t skipped() const { return _skipped; }
+
+    /**
+     * Resets lateness and activations statistics.
+     */
+    void resetStatistics();
+
+private:
+    const std::chrono::microseconds _period;
+    const MissedPolicy _policy;
+
+    std::chrono::steady_clock::time_point _started;
+
+    std::atomic<int64_t> _lastLateness = 0;
+    std::atomic<int64_t> _maxLateness = 0;
+    std::atomic<uint64_t> _activations = 0;
+    std::atomic<uint64_t> _skipped = 0;
+};
+
+}  // namespace cRIO
+}  // namespace LSST
+
+#endif /* !__cRIO_PeriodicTask__ */
@@ -26,6 +26,7 @@
 #include <cRIO/FPGA.h>
 #include <cRIO/IntelHex.h>
 #include <ILC/ILCBusList.h>
+#include <Modbus/CRC.h>
 
 namespace LSST {
 namespace cRIO {
@@ -74,7 +75,7 @@ public:
      * @see programILC
      */
     void writeApplicationPage(uint8_t address, uint16_t startAddress, uint16_t length,
-                              std::vector<uint8_t> data) {
+                              const std::vector<uint8_t> &data) {
         callFunction(address, ILC_CLI_CMD::WRITE_APPLICATION_PAGE, 500000, startAddress, length, data);
     }
 
@@ -188,7 +189,7 @@ protected:
 private:
     int _printout;
     uint8_t _lastAddress;
-    ModbusBuffer::CRC _crc;
+    Modbus::CRC _crc;
     uint16_t _startAddress;
     uint16_t _dataLength;
 
@@ -21,7 +21,7 @@
 #ifndef ROUNDROBIN_H_
 #define ROUNDROBIN_H_
 
-#include <cRIO/ILCDataTypes.h>
+#include <cstdint>
 
 namespace LSST {
 namespace cRIO {
@@ -25,12 +25,14 @@
 #define __CRIO_TASK__
 
 #include <chrono>
+#include <cstdint>
 #include <exception>
 
 namespace LSST {
 namespace cRIO {
 
 typedef uint32_t task_return_t;
+typedef uint32_t task_key_t;
 
 /**
  * Parent class for all tasks queued to operate on FPGA.
@@ -56,7 +58,37 @@ public:
      */
     virtual void reportException(const std::exception &ex) {};
 
+    /**
+     * Returns time of the next task execution. Called by the managing queue
+     * after run returned value other than DONT_RESCHEDULE. Default
+     * implementation schedules the task wait milliseconds after the task
+     * finished.
+     *
+     * @param deadline time the task was scheduled to run
+     * @param now time the task finished
+     * @param wait value returned from run
+     *
+     * @return time of the next execution
+     */
+    virtual std::chrono::steady_clock::time_point nextRun(std::chrono::steady_clock::time_point deadline,
+                                                          std::chrono::steady_clock::time_point now,
+                                                          task_return_t wait) {
+        return now + std::chrono::milliseconds(wait);
+    }
+
+    /**
+     * Returns serialization key. Tasks with the same key are run in order
+     * they are due, one at a time. Tasks with different keys can run in
+     * parallel if ControllerThread worker pool is enabled. Default key
+     * serializes the task with all tasks not overriding this method.
+     *
+     * @return task serialization key
+     */
+    virtual task_key_t serializationKey() const { return CONTROLLER_KEY; }
+
     static constexpr task_return_t DONT_RESCHEDULE = 0xFFFFFFFF;
+
+    static constexpr task_key_t CONTROLLER_KEY = 0;
 };
 
 }  // namespace cRIO
@@ -21,9 +21,12 @@
 #ifndef __TASKQUEUE_H__
 #define __TASKQUEUE_H__
 
+#include <atomic>
 #include <chrono>
-#include <queue>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -34,20 +37,94 @@ namespace cRIO {
 
 typedef std::pair<std::chrono::steady_clock::time_point, std::shared_ptr<Task>> task_t;
 
+/**
+ * Identifies scheduled task entry. Can be used to cancel or reschedule the
+ * entry. 0 is never used as valid handle.
+ */
+typedef uint64_t task_handle_t;
+
 /**
  * Scheduling entry. Holds task to execute and time when it shall be executed.
  */
 class TaskEntry : public task_t {
 public:
-    TaskEntry(std::chrono::steady_clock::time_point when, std::shared_ptr<Task> what) : task_t(when, what) {}
+    TaskEntry(std::chrono::steady_clock::time_point when, std::shared_ptr<Task> what,
+              task_handle_t _handle = 0)
+            : task_t(when, what), handle(_handle) {}
+
+    task_handle_t handle;  ///< entry handle, 0 if handle shall be assigned by TaskQueue::push
 };
 
 /**
  * Task queue management structure. Time-based priority queue, providing a
- * quick access to the next (time-wise) task to execute.
+ * quick access to the next (time-wise) task to execute. Entries scheduled
+ * for the same time are executed in the order they were pushed.
+ *
+ * Implemented as indexed 4-ary heap. Position of every entry in the heap is
+ * tracked by its handle, so an entry can be canceled or rescheduled in
+ * O(log n), without rebuilding the heap.
  */
-class TaskQueue : public std::priority_queue<TaskEntry, std::vector<TaskEntry>, std::greater<TaskEntry>> {
+class TaskQueue {
 public:
+    /**
+     * Returns new unique handle. Thread safe, can be used to assign handle
+     * to the entry before it is pushed into queue.
+     *
+     * @return new handle
+     */
+    static task_handle_t newHandle() { return _nextHandle.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * Adds entry into queue.
+     *
+     * @param entry entry to add. If entry handle is 0, new handle is assigned
+     *
+     * @return entry handle
+     *
+     * @throw std::runtime_error if an entry with the same handle is already queued
+     */
+    task_handle_t push(const TaskEntry &entry);
+
+    /**
+     * Returns entry to be executed first.
+     *
+     * @return the earliest entry. Undefined for empty queue
+     */
+    const TaskEntry &top() const { return _heap.front().entry; }
+
+    /**
+     * Removes the earliest entry.
+     */
+    void pop() { _erase(0); }
+
+    /**
+     * Removes entry from the queue.
+     *
+     * @param handle entry handle
+     *
+     * @return true if entry was removed, false if it wasn't queued
+     */
+    bool cancel(task_handle_t handle);
+
+    /**
+     * Changes time when entry shall be executed.
+     *
+     * @param handle entry handle
+     * @param when new execution time
+     *
+     * @return true if entry was rescheduled, false if it isn't queued
+     */
+    bool reschedule(task_handle_t handle, std::chrono::steady_clock::time_point when);
+
+    /**
+     * Returns true if the entry is queued.
+     *
+     * @param handle entry handle
+     *
+     * @return true if entry with the handle is in queue
+     */
+    bool contains(task_handle_t handle) const { return _index.find(handle) != _index.end(); }
+
     /**
      * Remove all task copies from the queue.
      *
@@ -56,6 +133,42 @@ public:
      * @return True if at least a single instance of the task was removed.
      */
     bool remove(std::shared_ptr<Task> what);
+
+    /**
+     * Removes all entries.
+     */
+    void clear();
+
+    bool empty() const { return _heap.empty(); }
+
+    size_t size() const { return _heap.size(); }
+
+    /**
+     * Heap arity.
+     */
+    static constexpr size_t ARITY = 4;
+
+private:
+    struct Node {
+        TaskEntry entry;
+        uint64_t order;
+    };
+
+    std::vector<Node> _heap;
+    std::unordered_map<task_handle_t, size_t> _index;
+    uint64_t _order = 0;
+
+    static std::atomic<task_handle_t> _nextHandle;
+
+    static bool _before(const Node &a, const Node &b) {
+        return a.entry.first < b.entry.first || (a.entry.first == b.entry.first && a.order < b.order);
+    }
+
+    void _erase(size_t pos);
+    void _place(size_t pos);
+    size_t _siftUp(size_t pos);
+    size_t _siftDown(size_t pos);
+    void _move(size_t to, Node &&node);
 };
 
 }  // namespace cRIO
@@ -23,6 +23,7 @@
 #ifndef _cRIO_ThermalILC_h
 #define _cRIO_ThermalILC_h
 
+#include <ILC/BroadcastCoalescer.h>
 #include <ILC/ILCBusList.h>
 
 namespace LSST {
@@ -132,6 +133,25 @@ public:
      */
     void broadcastThermalDemand(uint8_t heaterPWM[NUM_TS_ILC], uint8_t fanRPM[NUM_TS_ILC]);
 
+    /**
+     * Returns coalescer for thermal demand. Values set with
+     * coalescer.set(address, heaterPWM, fanRPM) are send as a single broadcast
+     * (as broadcastThermalDemand does) when at least threshold ILCs are
+     * commanded in a cycle, otherwise as setThermalDemand unicasts. Assumes
+     * ILCs at addresses 1 to NUM_TS_ILC, in broadcast payload order.
+     *
+     * Broadcast returns no status - processThermalStatus isn't called for
+     * ILCs commanded in a broadcast cycle, and the broadcast resends last
+     * known values of ILCs not commanded in the cycle. The default threshold
+     * is majority of the ILCs, where broadcast starts to save bus time over
+     * unicasts and their replies.
+     *
+     * @param threshold minimal number of ILCs commanded in cycle to use broadcast
+     *
+     * @return thermal demand coalescer
+     */
+    static ILC::BroadcastCoalescer thermalDemandCoalescer(size_t threshold = NUM_TS_ILC / 2 + 1);
+
 protected:
     /**
      * Called when response from call to command 89 (0x59) is read.
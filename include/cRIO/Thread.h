@@ -27,6 +27,10 @@
 #include <mutex>
 #include <thread>
 
+#include <pthread.h>
+
+#include <cRIO/ThreadAttributes.h>
+
 using namespace std::chrono_literals;
 
 namespace LSST {
@@ -63,6 +67,21 @@ public:
      */
     void stop(std::chrono::microseconds timeout = 2ms);
 
+    /**
+     * Sets thread attributes, applied on the next start. Attributes which
+     * cannot be applied are logged as warnings.
+     *
+     * @param attributes new thread attributes
+     */
+    void setAttributes(const ThreadAttributes& attributes);
+
+    /**
+     * Returns thread attributes.
+     *
+     * @return attributes applied when the thread is started
+     */
+    ThreadAttributes getAttributes();
+
     /**
      * Returns true if thread is joinable (~is running).
      *
@@ -113,8 +132,17 @@ protected:
      */
     virtual void run(std::unique_lock<std::mutex>& lock) = 0;
 
+    /**
+     * Called from stop after runCondition was notified. Subclasses waiting
+     * for other events than runCondition notification shall override this
+     * to wake up the thread, so it can check keepRunning.
+     */
+    virtual void wakeUp() {}
+
 private:
-    std::thread* _thread = nullptr;
+    // pthread, as std::thread cannot set stack size
+    pthread_t* _thread = nullptr;
+    ThreadAttributes _attributes;
 
     /*
      * Condition for start detection. Notified on call to _run. Without this,
@@ -125,6 +153,7 @@ private:
     bool _threadStarted = false;
 
     void _run();
+    static void* _start_routine(void* thread);
 };
 
 }  // namespace cRIO
@@ -0,0 +1,90 @@
+/*
+ * Real-time attributes of threads.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __cRIO_ThreadAttributes__
+#define __cRIO_ThreadAttributes__
+
+#include <cstddef>
+#include <vector>
+
+#include <sched.h>
+
+namespace LSST {
+namespace cRIO {
+
+/**
+ * Scheduling, CPU affinity and memory attributes of a thread. Passed to
+ * Thread::setAttributes (or Application::addThread), applied when the thread
+ * is started. Default values keep the system defaults.
+ *
+ * Attributes which cannot be applied (e.g. SCHED_FIFO without real-time
+ * privileges, non-existing CPU) are logged as warnings, and the thread runs
+ * without them.
+ *
+ * @code{.cpp}
+ * LSST::cRIO::ThreadAttributes rt;
+ * rt.policy = SCHED_FIFO;
+ * rt.priority = 80;
+ * rt.cpus = {1};
+ * rt.stackPrefault = 256 * 1024;
+ * rt.lockMemory = true;
+ *
+ * ControllerThread::instance().setAttributes(rt);
+ * @endcode
+ */
+struct ThreadAttributes {
+    int policy = SCHED_OTHER;  ///< scheduling policy (SCHED_OTHER, SCHED_FIFO, SCHED_RR)
+    int priority = 0;          ///< scheduling priority, shall be 0 for SCHED_OTHER
+    std::vector<int> cpus;     ///< CPUs the thread can run on, empty for no pinning
+    size_t stackSize = 0;      ///< thread stack size in bytes, 0 for the default size
+    size_t stackPrefault = 0;  ///< stack bytes touched when thread starts, so they don't fault later
+    bool lockMemory = false;   ///< lock current and future process memory (process-wide mlockall)
+
+    /**
+     * Returns true if all attributes are set to the defaults.
+     *
+     * @return true if no attribute shall be applied
+     */
+    bool empty() const;
+
+    /**
+     * Locks process memory if lockMemory is set. Memory is locked only once
+     * per process.
+     *
+     * @return false if memory locking failed
+     */
+    bool lockProcessMemory() const;
+
+    /**
+     * Applies scheduling, affinity and stack prefault to the calling thread.
+     *
+     * @param name thread name, used in warnings
+     *
+     * @return false if any attribute cannot be applied
+     */
+    bool applyToCurrentThread(const char *name = "thread") const;
+};
+
+}  // namespace cRIO
+}  // namespace LSST
+
+#endif /* !__cRIO_ThreadAttributes__ */
@@ -0,0 +1,176 @@
+/*
+ * Pool of worker threads running jobs serialized by keys.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __cRIO_WorkerPool__
+#define __cRIO_WorkerPool__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <cRIO/Task.h>
+
+namespace LSST {
+namespace cRIO {
+
+/**
+ * Pool of worker threads with work stealing. Jobs are submitted with a
+ * serialization key. Jobs with the same key are run one at a time, in the
+ * order they were submitted. Jobs with different keys run in parallel.
+ *
+ * Jobs with the same key form a strand. Strand with pending jobs is queued
+ * on a worker's deque - on deque of the submitting worker if the job is
+ * submitted from a job, or on workers' deques in round-robin order. Worker
+ * takes strands from the back of its own deque, and steals from the front
+ * of other workers' deques if its own deque is empty. A single job of the
+ * strand is run each time the strand is taken, so a busy strand doesn't
+ * starve others.
+ *
+ * @code{.cpp}
+ * LSST::cRIO::WorkerPool pool(3);
+ * pool.submit(1, []() { programILC(1); });
+ * pool.submit(2, []() { programILC(2); });
+ * @endcode
+ */
+class WorkerPool {
+public:
+    typedef std::function<void()> job_t;
+
+    /**
+     * Starts worker threads.
+     *
+     * @param workers number of worker threads
+     *
+     * @throw std::invalid_argument if workers is 0
+     */
+    WorkerPool(size_t workers);
+
+    /**
+     * Runs all submitted jobs and joins worker threads.
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Submits job for execution.
+     *
+     * @param key serialization key
+     * @param job job to run. Exceptions thrown from the job are logged and
+     * ignored
+     */
+    void submit(task_key_t key, job_t job);
+
+    /**
+     * Adds signal job for the key. The job is run in the key's strand after
+     * signal is called, serialized with jobs submitted with the key, ahead of
+     * jobs already queued. Signals raised before the job starts are coalesced
+     * into a single run. Signal
+     * strand and job are allocated here, so signal doesn't allocate.
+     *
+     * @param key serialization key
+     * @param job job run when signal is raised. Exceptions thrown from the
+     * job are logged and ignored
+     *
+     * @throw std::runtime_error if signal for the key was already added
+     */
+    void addSignal(task_key_t key, job_t job);
+
+    /**
+     * Raises signal for the key. Doesn't allocate.
+     *
+     * @param key serialization key, shall be added with addSignal
+     *
+     * @throw std::out_of_range if signal for the key wasn't added
+     */
+    void signal(task_key_t key);
+
+    /**
+     * Returns number of worker threads.
+     *
+     * @return number of workers
+     */
+    size_t workers() const { return _workers.size(); }
+
+    /**
+     * Returns number of jobs submitted but not yet finished.
+     *
+     * @return number of pending jobs
+     */
+    size_t pending() const { return _pendingJobs; }
+
+private:
+    struct Strand {
+        Strand(task_key_t _key) : key(_key) {}
+
+        const task_key_t key;
+        // guarded by _strandsMutex
+        std::deque<job_t> jobs;
+        // signal job, strand with signal is kept in _strands
+        job_t signalJob;
+        bool signalled = false;
+        bool scheduled = true;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Strand>> strands;
+        std::thread thread;
+    };
+
+    void _run(size_t index);
+    void _schedule(std::shared_ptr<Strand> strand, bool requeue = false);
+    std::shared_ptr<Strand> _take(size_t index);
+    void _runStrand(std::shared_ptr<Strand> strand);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::atomic<size_t> _nextWorker = 0;
+
+    // strands with pending jobs
+    std::mutex _strandsMutex;
+    std::unordered_map<task_key_t, std::shared_ptr<Strand>> _strands;
+
+    // scheduled strands with signal, capacity reserved so scheduling doesn't allocate
+    std::mutex _signalledMutex;
+    std::vector<std::shared_ptr<Strand>> _signalled;
+    size_t _signalCount = 0;
+
+    std::atomic<size_t> _pendingJobs = 0;
+
+    // number of strands queued on workers' deques and in _signalled
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+    std::atomic<size_t> _queued = 0;
+    bool _stopping = false;
+};
+
+}  // namespace cRIO
+}  // namespace LSST
+
+#endif /* !__cRIO_WorkerPool__ */
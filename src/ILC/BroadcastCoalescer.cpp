@@ -0,0 +1,107 @@
+/*
+ * Coalesces ILC unicast set commands into broadcast.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <ILC/BroadcastCoalescer.h>
+
+using namespace ILC;
+
+BroadcastCoalescer::BroadcastCoalescer(uint8_t func, uint32_t timing, uint8_t broadcastAddress,
+                                       uint32_t broadcastDelay, const std::vector<uint8_t> &addresses,
+                                       size_t payloadSize, size_t threshold)
+        : _func(func),
+          _timing(timing),
+          _broadcastAddress(broadcastAddress),
+          _broadcastDelay(broadcastDelay),
+          _addresses(addresses),
+          _payloadSize(payloadSize),
+          _threshold(threshold),
+          _payload(addresses.size() * payloadSize),
+          _unicast(payloadSize) {
+    _slots.fill(-1);
+    for (size_t i = 0; i < _addresses.size(); i++) {
+        _slots[_addresses[i]] = i;
+    }
+    clear();
+}
+
+void BroadcastCoalescer::setPayload(uint8_t address, const uint8_t *payload, size_t length) {
+    auto slot = _slots[address];
+    if (slot < 0) {
+        throw std::out_of_range(
+                fmt::format("Address {} isn't handled by function {} broadcast coalescer", address, _func));
+    }
+    if (length != _payloadSize) {
+        throw std::runtime_error(fmt::format("Invalid payload length for function {} - expected {}, got {}",
+                                             _func, _payloadSize, length));
+    }
+
+    memcpy(_payload.data() + slot * _payloadSize, payload, length);
+
+    if (_known[slot] == false) {
+        _known[slot] = true;
+        _knownCount++;
+    }
+    if (_pending[slot] == false) {
+        _pending[slot] = true;
+        _pendingCount++;
+    }
+}
+
+bool BroadcastCoalescer::flush(ILCBusList &busList) {
+    if (_pendingCount == 0) {
+        return false;
+    }
+
+    bool broadcast = _pendingCount >= _threshold && _knownCount == _addresses.size();
+
+    if (broadcast) {
+        busList.broadcastFunction(_broadcastAddress, _func, _broadcastDelay, busList.nextBroadcastCounter(),
+                                  _payload);
+    }
+
+    for (size_t slot = 0; slot < _addresses.size(); slot++) {
+        if (_pending[slot] == false) {
+            continue;
+        }
+        if (broadcast == false) {
+            auto start = _payload.begin() + slot * _payloadSize;
+            _unicast.assign(start, start + _payloadSize);
+            busList.callFunction(_addresses[slot], _func, _timing, _unicast);
+        }
+        _pending[slot] = false;
+    }
+    _pendingCount = 0;
+
+    return broadcast;
+}
+
+void BroadcastCoalescer::clear() {
+    _known.assign(_addresses.size(), false);
+    _pending.assign(_addresses.size(), false);
+    _knownCount = 0;
+    _pendingCount = 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Fills ILC bus list with commands fitting into a cycle.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+#include <cRIO/RoundRobin.h>
+#include <ILC/CycleScheduler.h>
+
+using namespace ILC;
+using namespace LSST::cRIO;
+
+CycleScheduler::CycleScheduler(uint32_t budget, uint32_t baudRate, uint32_t bitsPerByte)
+        : _budget(budget), _baudRate(baudRate), _bitsPerByte(bitsPerByte) {}
+
+void CycleScheduler::add(Priority priority, Command command, const std::vector<FrameModel> &frames) {
+    if (priority != Priority::CRITICAL && frames.empty()) {
+        throw std::invalid_argument("Frames of periodic and background scheduled commands must be specified");
+    }
+
+    Entry entry{command};
+    for (auto &frame : frames) {
+        entry.declared += commandTime(frame.length, frame.timing);
+    }
+    entry.time = entry.declared;
+
+    switch (priority) {
+        case Priority::CRITICAL:
+            _critical.push_back(entry);
+            break;
+        case Priority::PERIODIC:
+            _periodic.entries.push_back(entry);
+            break;
+        case Priority::BACKGROUND:
+            _background.entries.push_back(entry);
+            break;
+    }
+}
+
+void CycleScheduler::clear() {
+    _critical.clear();
+    _periodic = Queue();
+    _background = Queue();
+}
+
+uint32_t CycleScheduler::fill(ILCBusList &busList) {
+    busList.clear();
+
+    uint32_t used = 0;
+    for (auto &entry : _critical) {
+        _emit(entry, busList, used, true);
+    }
+
+    _fillQueue(_periodic, busList, used);
+    _fillQueue(_background, busList, used);
+
+    return used;
+}
+
+void CycleScheduler::setBudget(uint32_t budget) {
+    _budget = budget;
+    for (auto queue : {&_periodic, &_background}) {
+        for (auto &entry : queue->entries) {
+            entry.reported = false;
+        }
+    }
+}
+
+uint32_t CycleScheduler::commandTime(size_t length, uint32_t timing) const {
+    // wait time as encoded in FIFO::TX_WAIT_RX or FIFO::TX_WAIT_LONG_RX
+    uint32_t wait = timing > 0x0FFF ? (timing / 1000 + 1) * 1000 : timing;
+    uint64_t bits = static_cast<uint64_t>(length) * _bitsPerByte * 1000000;
+    return (bits + _baudRate - 1) / _baudRate + wait;
+}
+
+bool CycleScheduler::_emit(Entry &entry, ILCBusList &busList, uint32_t &used, bool force) {
+    if (force == false) {
+        if (entry.time > _budget) {
+            if (entry.reported == false) {
+                SPDLOG_WARN(
+                        "Scheduled command takes {} us, more than cycle budget {} us - it will not be sent",
+                        entry.time, _budget);
+                entry.reported = true;
+            }
+            return false;
+        }
+
+        if (used + entry.time > _budget) {
+            return false;
+        }
+    }
+
+    size_t first = busList.size();
+    entry.command(busList);
+
+    uint32_t emitted = 0;
+    for (size_t i = first; i < busList.size(); i++) {
+        emitted += commandTime(busList[i]);
+    }
+    // command can add no frames (unchanged value, conditional command) - don't lower the estimate
+    entry.time = std::max(entry.declared, emitted);
+
+    used += emitted;
+    return true;
+}
+
+void CycleScheduler::_fillQueue(Queue &queue, ILCBusList &busList, uint32_t &used) {
+    int32_t size = queue.entries.size();
+    if (size == 0) {
+        return;
+    }
+
+    int32_t skipped = -1;
+    int32_t index = queue.next;
+    for (int32_t i = 0; i < size; i++, index = RoundRobin::Inc(index, size)) {
+        auto &entry = queue.entries[index];
+        // commands longer than budget never fit, and shall not block the other commands
+        if (_emit(entry, busList, used, false) == false && skipped < 0 && entry.time <= _budget) {
+            skipped = index;
+        }
+    }
+
+    // continue with the first command which didn't fit
+    if (skipped >= 0) {
+        queue.next = skipped;
+    }
+}
@@ -27,7 +27,10 @@
 using namespace ILC;
 
 ILCBusList::ILCBusList(uint8_t bus) : _bus(bus) {
-    add_response(ILC_CMD::SERVER_ID, [this](Modbus::Parser parser) {
+    // address, function, firmware name length, CRC + variable data
+    addResponseLength(ILC_CMD::SERVER_ID, 5, 2);
+
+    add_response(ILC_CMD::SERVER_ID, [this](Modbus::ParserView &parser) {
         uint8_t fnLen = parser.read<uint8_t>();
         if (fnLen < 12) {
             throw std::runtime_error(fmt::format(
@@ -48,42 +51,69 @@ ILCBusList::ILCBusList(uint8_t bus) : _bus(bus) {
                         networkNodeOptions, majorRev, minorRev, fwName);
     });
 
-    add_response(ILC_CMD::SERVER_STATUS, [this](Modbus::Parser parser) {
-        uint8_t mode = parser.read<uint8_t>();
-        uint16_t status = parser.read<uint16_t>();
-        uint16_t faults = parser.read<uint16_t>();
-        parser.checkCRC();
-        _lastMode[parser.address()] = mode;
-        processServerStatus(parser.address(), mode, status, faults);
-    });
+    addReply<Modbus::Reply<uint8_t, uint16_t, uint16_t>>(
+            ILC_CMD::SERVER_STATUS, [this](uint8_t address, uint8_t mode, uint16_t status, uint16_t faults) {
+                _lastMode.set(address, mode);
+                processServerStatus(address, mode, status, faults);
+            });
 
-    add_response(
+    addReply<Modbus::Reply<uint16_t>>(
             ILC_CMD::CHANGE_MODE,
-            [this](Modbus::Parser parser) {
-                uint16_t mode = parser.read<uint16_t>();
-                parser.checkCRC();
-                _lastMode[parser.address()] = mode;
-                processChangeILCMode(parser.address(), mode);
+            [this](uint8_t address, uint16_t mode) {
+                _lastMode.set(address, mode);
+                processChangeILCMode(address, mode);
             },
             [this](uint8_t address, uint8_t error) {
                 SPDLOG_WARN("Cannot change mode of ILC with address {0} - response {1} ({1:02x})", address,
                             error);
             });
 
-    add_response(ILC_CMD::SET_TEMP_ADDRESS, [this](Modbus::Parser parser) {
-        uint8_t newAddress = parser.read<uint8_t>();
-        parser.checkCRC();
-        processSetTempILCAddress(parser.address(), newAddress);
+    addReply<Modbus::Reply<uint8_t>>(ILC_CMD::SET_TEMP_ADDRESS, [this](uint8_t address, uint8_t newAddress) {
+        processSetTempILCAddress(address, newAddress);
     });
 
-    add_response(ILC_CMD::RESET_SERVER, [this](Modbus::Parser parser) {
-        parser.checkCRC();
-        processResetServer(parser.address());
+    addReply<Modbus::Reply<>>(ILC_CMD::RESET_SERVER, [this](uint8_t address) {
+        // reset ILC lost its parameters
+        changeCache().invalidate(address);
+        processResetServer(address);
     });
 }
 
 ILCBusList::~ILCBusList() {}
 
+int ILCBusList::responseLength(const std::vector<uint8_t> &response) {
+    if (response.size() < 2) {
+        return -1;
+    }
+
+    // address, function, error code, CRC
+    if (response[1] & MODBUS_ERROR_MASK) {
+        return Modbus::Reply<uint8_t>::LENGTH;
+    }
+
+    if (_addressResponseLengths.empty() == false) {
+        auto it = _addressResponseLengths.find(_key(response[0], response[1]));
+        if (it != _addressResponseLengths.end()) {
+            return it->second;
+        }
+    }
+
+    auto length = _responseLengths.find(response[1]);
+    if (length == nullptr) {
+        return -1;
+    }
+
+    if (length->lengthIndex == 0) {
+        return length->length;
+    }
+
+    if (response.size() <= length->lengthIndex) {
+        return -1;
+    }
+
+    return length->length + response[length->lengthIndex];
+}
+
 uint8_t ILCBusList::nextBroadcastCounter() {
     _broadcastCounter++;
     if (_broadcastCounter > 15) {
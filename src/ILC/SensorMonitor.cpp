@@ -20,6 +20,7 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <stdexcept>
 #include <vector>
 
 #include <spdlog/spdlog.h>
@@ -29,7 +30,7 @@
 using namespace ILC;
 
 SensorMonitor::SensorMonitor(uint8_t bus) : ILCBusList(bus) {
-    add_response(SENSOR_VALUES, [this](Modbus::Parser parser) {
+    add_response(SENSOR_VALUES, [this](Modbus::ParserView &parser) {
         std::vector<float> values;
         // there should be 2 bytes (address, function), 4 bytes floats and 2 bytes CRC - so the size()
         // shall be multiple of 4
@@ -45,3 +46,15 @@ SensorMonitor::SensorMonitor(uint8_t bus) : ILCBusList(bus) {
         processSensorValues(parser.address(), values);
     });
 }
+
+void SensorMonitor::setSensorCount(uint8_t address, uint8_t count) {
+    // address, function, 4 bytes per sensor value and CRC
+    size_t length = 4 + 4 * static_cast<size_t>(count);
+    if (length > Modbus::Frame::MAX_LENGTH) {
+        throw std::out_of_range(
+                fmt::format("Cannot set {} sensors for ILC {} - reply would be {} bytes long, Modbus frame "
+                            "is limited to {} bytes",
+                            count, address, length, Modbus::Frame::MAX_LENGTH));
+    }
+    setResponseLength(address, SENSOR_VALUES, length);
+}
@@ -102,6 +102,12 @@ void Application::addThread(Thread* thread, std::chrono::microseconds timeout) {
     thread->start(timeout);
 }
 
+void Application::addThread(Thread* thread, const ThreadAttributes& attributes,
+                            std::chrono::microseconds timeout) {
+    thread->setAttributes(attributes);
+    addThread(thread, timeout);
+}
+
 size_t Application::runningThreads() {
     std::lock_guard<std::mutex> lockG(_threadsMutex);
     size_t ret = 0;
@@ -35,42 +35,99 @@ using namespace LSST::cRIO;
 ControllerThread::ControllerThread(token) { SPDLOG_DEBUG("ControllerThread: ControllerThread()"); }
 
 ControllerThread::~ControllerThread() {
-    delete _interrupt_watcher_thread;
+    // Thread destructor cannot call wakeUp override
+    stop();
+    setWorkers(0);
+    stopInterruptWatcherTask();
     clear();
 }
 
-void ControllerThread::enqueue(std::shared_ptr<Task> task) {
-    enqueue_at(task, std::chrono::steady_clock::now() + 1ms);
+task_handle_t ControllerThread::enqueue(std::shared_ptr<Task> task) {
+    return enqueue_at(task, std::chrono::steady_clock::now() + 1ms);
 }
 
-void ControllerThread::enqueue_at(std::shared_ptr<Task> task, std::chrono::steady_clock::time_point when) {
+task_handle_t ControllerThread::enqueue_at(std::shared_ptr<Task> task,
+                                           std::chrono::steady_clock::time_point when) {
     SPDLOG_TRACE("ControllerThread: enqueue at {}",
                  std::chrono::duration_cast<std::chrono::seconds>(when.time_since_epoch()).count());
+    try {
+        if (task->validate()) {
+            auto handle = TaskQueue::newHandle();
+            _ingress.push(TaskEntry(when, task, handle));
+            return handle;
+        }
+    } catch (std::exception& ex) {
+        task->reportException(ex);
+    }
+    return 0;
+}
+
+bool ControllerThread::cancel(task_handle_t handle) {
+    std::lock_guard<std::mutex> lg(runMutex);
+    _drain_ingress();
+    return _task_queue.cancel(handle);
+}
+
+bool ControllerThread::reschedule(task_handle_t handle, std::chrono::steady_clock::time_point when) {
+    bool ret;
     {
         std::lock_guard<std::mutex> lg(runMutex);
-        try {
-            if (task->validate()) {
-                _task_queue.push(TaskEntry(when, task));
-            }
-        } catch (std::exception& ex) {
-            task->reportException(ex);
-        }
+        _drain_ingress();
+        ret = _task_queue.reschedule(handle, when);
     }
-    runCondition.notify_one();
+    // the controller may wait for later time
+    wakeUp();
+    return ret;
 }
 
 bool ControllerThread::remove(std::shared_ptr<Task> task) {
+    std::lock_guard<std::mutex> lg(runMutex);
+    _drain_ingress();
+    return _task_queue.remove(task);
+}
+
+size_t ControllerThread::size() {
+    std::lock_guard<std::mutex> lg(runMutex);
+    _drain_ingress();
+    return _task_queue.size();
+}
+
+void ControllerThread::setWorkers(size_t workers) {
+    std::unique_ptr<WorkerPool> old_pool;
     {
         std::lock_guard<std::mutex> lg(runMutex);
-        return _task_queue.remove(task);
+        old_pool = std::move(_worker_pool);
+        if (workers > 0) {
+            _worker_pool = std::make_unique<WorkerPool>(workers);
+            _worker_pool->addSignal(Task::CONTROLLER_KEY, [this]() {
+                try {
+                    checkInterrupts(_pending_interrupts.exchange(0));
+                } catch (std::exception& ex) {
+                    SPDLOG_ERROR("ControllerThread: interrupt handler failed: {}", ex.what());
+                }
+            });
+        }
     }
+    // finishing tasks lock runMutex
+    old_pool.reset();
+}
+
+size_t ControllerThread::getWorkers() {
+    std::lock_guard<std::mutex> lg(runMutex);
+    return _worker_pool ? _worker_pool->workers() : 0;
 }
 
-void ControllerThread::startInterruptWatcherTask(FPGA* fpga) {
-    _interrupt_watcher_thread = new InterruptWatcherThread(fpga);
+void ControllerThread::startInterruptWatcherTask(FPGA* fpga, const ThreadAttributes& attributes) {
+    stopInterruptWatcherTask();
+    _interrupt_watcher_thread = new InterruptWatcherThread(fpga, attributes);
     _interrupt_watcher_thread->start();
 }
 
+void ControllerThread::stopInterruptWatcherTask() {
+    delete _interrupt_watcher_thread;
+    _interrupt_watcher_thread = nullptr;
+}
+
 void ControllerThread::setInterruptHandler(std::shared_ptr<InterruptHandler> handler, uint8_t irq) {
     if ((irq == 0) || (irq > CRIO_INTERRUPTS)) {
         throw std::runtime_error(fmt::format("Interrupt number should fall between 1 and {} - {} specified",
@@ -85,19 +142,38 @@ void ControllerThread::setInterruptHandler(std::shared_ptr<InterruptHandler> han
 
 void ControllerThread::run(std::unique_lock<std::mutex>& lock) {
     SPDLOG_INFO("ControllerThread: Run");
-    // process already queued tasks
-    _process_tasks();
-    while (keepRunning) {
-        if (_task_queue.empty()) {
-            runCondition.wait(lock);
-        } else {
-            runCondition.wait_until(lock, _task_queue.top().first);
+    while (true) {
+        // sequence must be read before keepRunning and ingress are checked, so no wake up is lost
+        auto sequence = _ingress.signal.sequence();
+        if (keepRunning == false) {
+            break;
         }
+
+        _dispatch_interrupts();
+        _drain_ingress();
         _process_tasks();
+
+        // tasks running in worker pool are queued at time_point::max
+        bool empty = _task_queue.empty() ||
+                     _task_queue.top().first == std::chrono::steady_clock::time_point::max();
+        auto next = empty ? std::chrono::steady_clock::time_point() : _task_queue.top().first;
+
+        lock.unlock();
+        if (empty) {
+            _ingress.signal.wait(sequence);
+        } else {
+            _ingress.signal.wait_until(sequence, next);
+        }
+        lock.lock();
     }
     SPDLOG_INFO("ControllerThread: Completed");
 }
 
+void ControllerThread::signalInterrupts(uint32_t triggeredInterrupts) {
+    _interrupt_ring.push(triggeredInterrupts);
+    _ingress.signal.notify();
+}
+
 void ControllerThread::checkInterrupts(uint32_t triggeredIterrupts) {
     for (uint8_t i = 0; i < CRIO_INTERRUPTS; i++, triggeredIterrupts >>= 1) {
         if ((triggeredIterrupts & 0x01) == 0x01) {
@@ -114,36 +190,88 @@ void ControllerThread::clear() {
     SPDLOG_TRACE("ControllerThread: clear()");
     {
         std::lock_guard<std::mutex> lg(runMutex);
-        TaskQueue empty;
-        std::swap(_task_queue, empty);
+        _ingress.drain([](TaskEntry&&) {});
+        _task_queue.clear();
     }
 }
 
-// runMutex must be locked by calling method to guard _task_queue access!!
-void ControllerThread::_process_tasks() {
-    if (_task_queue.empty()) {
+// runMutex must be locked by calling method - only a single thread can drain ingress
+void ControllerThread::_drain_ingress() {
+    _ingress.drain([this](TaskEntry&& entry) { _task_queue.push(std::move(entry)); });
+}
+
+// runMutex must be locked by calling method, is unlocked while handlers run
+void ControllerThread::_dispatch_interrupts() {
+    auto triggered = _interrupt_ring.drain();
+    if (triggered == 0) {
         return;
     }
 
+    // handlers shall not run in parallel with tasks with the default key
+    if (_worker_pool) {
+        // pending interrupts are ORed until the signal job runs, signal doesn't allocate
+        _pending_interrupts |= triggered;
+        _worker_pool->signal(Task::CONTROLLER_KEY);
+        return;
+    }
+
+    runMutex.unlock();
+    try {
+        checkInterrupts(triggered);
+    } catch (std::exception& ex) {
+        SPDLOG_ERROR("ControllerThread: interrupt handler failed: {}", ex.what());
+    }
+    runMutex.lock();
+}
+
+// runMutex must be locked by calling method to guard _task_queue access!!
+void ControllerThread::_process_tasks() {
     auto now = std::chrono::steady_clock::now();
-    auto task = _task_queue.top();
-    while (task.first <= now) {
-        _task_queue.pop();
-        try {
-            runMutex.unlock();
-            auto wait = task.second->run();
-            runMutex.lock();
-
-            if (wait != Task::DONT_RESCHEDULE) {
-                _task_queue.push(TaskEntry(std::chrono::steady_clock::now() + std::chrono::milliseconds(wait),
-                                           task.second));
-            }
-        } catch (std::exception& ex) {
-            task.second->reportException(ex);
-        }
-        if (_task_queue.empty()) {
-            return;
+    // tasks may be enqueued faster than processed - check keepRunning so stop isn't delayed
+    while (keepRunning && _task_queue.empty() == false && _task_queue.top().first <= now) {
+        // task remains queued while running, so it can be canceled
+        auto deadline = _task_queue.top().first;
+        auto task = _task_queue.top().second;
+        auto handle = _task_queue.top().handle;
+
+        if (_worker_pool) {
+            // moved out of due tasks until it finishes
+            _task_queue.reschedule(handle, std::chrono::steady_clock::time_point::max());
+            _worker_pool->submit(task->serializationKey(), [this, task, handle, deadline]() {
+                auto wait = _run_task(task);
+                {
+                    std::lock_guard<std::mutex> lg(runMutex);
+                    _finish_task(task, handle, deadline, wait);
+                }
+                wakeUp();
+            });
+            continue;
         }
-        task = _task_queue.top();
+
+        runMutex.unlock();
+        auto wait = _run_task(task);
+        runMutex.lock();
+
+        _finish_task(task, handle, deadline, wait);
+    }
+}
+
+task_return_t ControllerThread::_run_task(std::shared_ptr<Task> task) {
+    try {
+        return task->run();
+    } catch (std::exception& ex) {
+        task->reportException(ex);
+    }
+    return Task::DONT_RESCHEDULE;
+}
+
+// runMutex must be locked by calling method
+void ControllerThread::_finish_task(std::shared_ptr<Task> task, task_handle_t handle,
+                                    std::chrono::steady_clock::time_point deadline, task_return_t wait) {
+    // task canceled while running isn't in the queue, so it isn't rescheduled
+    if (wait == Task::DONT_RESCHEDULE) {
+        _task_queue.cancel(handle);
+    } else {
+        _task_queue.reschedule(handle, task->nextRun(deadline, std::chrono::steady_clock::now(), wait));
     }
 }
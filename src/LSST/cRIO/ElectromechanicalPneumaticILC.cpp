@@ -27,50 +27,36 @@
 using namespace LSST::cRIO;
 
 ElectromechanicalPneumaticILC::ElectromechanicalPneumaticILC(uint8_t bus) : ILC::ILCBusList(bus) {
-    auto stepperForceStatus = [this](Modbus::Parser parser) {
-        uint8_t status = parser.read<uint8_t>();
-        int32_t encoderPosition = parser.read<int32_t>();
-        float loadCellForce = parser.read<float>();
-        parser.checkCRC();
-        processStepperForceStatus(parser.address(), status, encoderPosition, loadCellForce);
-    };
-
-    auto dcaGain = [this](Modbus::Parser parser) {
-        float primaryGain = parser.read<float>();
-        float secondaryGain = parser.read<float>();
-        parser.checkCRC();
-        processDCAGain(parser.address(), primaryGain, secondaryGain);
-    };
+    typedef Modbus::Reply<uint8_t, int32_t, float> StepperForceStatusReply;
+    typedef Modbus::Reply<uint8_t, float> SAAForceStatusReply;
+    typedef Modbus::Reply<uint8_t, float, float> DAAForceStatusReply;
 
-    auto hardpointLVDT = [this](Modbus::Parser parser) {
-        float breakwayLVDT = parser.read<float>();
-        float displacementLVDT = parser.read<float>();
-        parser.checkCRC();
-        processHardpointLVDT(parser.address(), breakwayLVDT, displacementLVDT);
+    auto stepperForceStatus = [this](uint8_t address, uint8_t status, int32_t encoderPosition,
+                                     float loadCellForce) {
+        processStepperForceStatus(address, status, encoderPosition, loadCellForce);
     };
 
-    auto forceActuatorForceStatus = [this](Modbus::Parser parser) {
-        uint8_t status = parser.read<uint8_t>();
-        float primary = parser.read<float>();
+    auto forceActuatorForceStatus = [this](Modbus::ParserView &parser) {
         switch (parser.size()) {
-            case 9: {
-                parser.checkCRC();
-                processSAAForceStatus(parser.address(), status, primary);
+            case SAAForceStatusReply::LENGTH:
+                SAAForceStatusReply::dispatch(parser, [this](uint8_t address, uint8_t status, float primary) {
+                    processSAAForceStatus(address, status, primary);
+                });
                 break;
-            }
-            case 13: {
-                float secondary = parser.read<float>();
-                parser.checkCRC();
-                processDAAForceStatus(parser.address(), status, primary, secondary);
+            case DAAForceStatusReply::LENGTH:
+                DAAForceStatusReply::dispatch(
+                        parser, [this](uint8_t address, uint8_t status, float primary, float secondary) {
+                            processDAAForceStatus(address, status, primary, secondary);
+                        });
                 break;
-            }
             default:
-                throw std::runtime_error(
-                        fmt::format("Invalid reply length - {}, expected 9 or 13", parser.size()));
+                throw std::runtime_error(fmt::format("Invalid reply length - {}, expected {} or {}",
+                                                     parser.size(), SAAForceStatusReply::LENGTH,
+                                                     DAAForceStatusReply::LENGTH));
         }
     };
 
-    auto calibrationData = [this](Modbus::Parser parser) {
+    auto calibrationData = [this](Modbus::ParserView &parser) {
         float mainADCK[4], mainOffset[4], mainSensitivity[4], backupADCK[4], backupOffset[4],
                 backupSensitivity[4];
         auto read4 = [this, &parser](float a[4]) {
@@ -89,34 +75,36 @@ ElectromechanicalPneumaticILC::ElectromechanicalPneumaticILC(uint8_t bus) : ILC:
                                backupOffset, backupSensitivity);
     };
 
-    auto pressureData = [this](Modbus::Parser parser) {
-        float primaryPush, primaryPull, secondaryPush, secondaryPull;
-        primaryPush = parser.read<float>();
-        primaryPull = parser.read<float>();
-        secondaryPull = parser.read<float>();
-        secondaryPush = parser.read<float>();
-        parser.checkCRC();
-        processMezzaninePressure(parser.address(), primaryPush, primaryPull, secondaryPush, secondaryPull);
-    };
-
-    add_response(ILC_EM_CMD::SET_STEPPER_STEPS, stepperForceStatus);
+    addReply<StepperForceStatusReply>(ILC_EM_CMD::SET_STEPPER_STEPS, stepperForceStatus);
 
-    add_response(ILC_EM_CMD::STEPPER_FORCE_STATUS, stepperForceStatus);
+    addReply<StepperForceStatusReply>(ILC_EM_CMD::STEPPER_FORCE_STATUS, stepperForceStatus);
 
-    add_response(ILC_EM_CMD::SET_DCA_GAIN, [this](Modbus::Parser parser) { parser.checkCRC(); });
+    addReply<Modbus::Reply<>>(ILC_EM_CMD::SET_DCA_GAIN, [](uint8_t address) {});
 
-    add_response(ILC_EM_CMD::REPORT_DCA_GAIN, dcaGain);
+    addReply<Modbus::Reply<float, float>>(ILC_EM_CMD::REPORT_DCA_GAIN,
+                                          [this](uint8_t address, float primaryGain, float secondaryGain) {
+                                              processDCAGain(address, primaryGain, secondaryGain);
+                                          });
 
+    // force status replies length depends on actuator type (single or dual axis) - set with setResponseLength
     add_response(ILC_EM_CMD::SET_FORCE_OFFSET, forceActuatorForceStatus);
 
     add_response(ILC_EM_CMD::REPORT_FA_FORCE_STATUS, forceActuatorForceStatus);
 
-    add_response(ILC_EM_CMD::SET_OFFSET_AND_SENSITIVITY,
-                 [this](Modbus::Parser parser) { parser.checkCRC(); });
+    addReply<Modbus::Reply<>>(ILC_EM_CMD::SET_OFFSET_AND_SENSITIVITY, [](uint8_t address) {});
 
+    addResponseLength(ILC_EM_CMD::REPORT_CALIBRATION_DATA, 4 + 6 * CALIBRATION_LENGTH * 4);
     add_response(ILC_EM_CMD::REPORT_CALIBRATION_DATA, calibrationData);
 
-    add_response(ILC_EM_CMD::REPORT_MEZZANINE_PRESSURE, pressureData);
-
-    add_response(ILC_EM_CMD::REPORT_HARDPOINT_LVDT, hardpointLVDT);
+    addReply<Modbus::Reply<float, float, float, float>>(
+            ILC_EM_CMD::REPORT_MEZZANINE_PRESSURE,
+            [this](uint8_t address, float primaryPush, float primaryPull, float secondaryPull,
+                   float secondaryPush) {
+                processMezzaninePressure(address, primaryPush, primaryPull, secondaryPush, secondaryPull);
+            });
+
+    addReply<Modbus::Reply<float, float>>(ILC_EM_CMD::REPORT_HARDPOINT_LVDT,
+                                          [this](uint8_t address, float breakwayLVDT, float displacementLVDT) {
+                                              processHardpointLVDT(address, breakwayLVDT, displacementLVDT);
+                                          });
 }
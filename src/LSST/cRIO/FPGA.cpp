@@ -20,6 +20,8 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
+#include <exception>
 #include <string.h>
 #include <thread>
 
@@ -32,7 +34,7 @@
 namespace LSST {
 namespace cRIO {
 
-FPGA::FPGA(fpgaType type) : SimpleFPGA(type) {
+FPGA::FPGA(fpgaType type) : SimpleFPGA(type), _submittedIrqs(0) {
     switch (type) {
         case SS:
             _modbusSoftwareTrigger = 252;
@@ -48,124 +50,245 @@ FPGA::FPGA(fpgaType type) : SimpleFPGA(type) {
 }
 
 void FPGA::ilcCommands(ILC::ILCBusList &ilc, int32_t timeout) {
+    auto submission = ilcSubmit(ilc);
+    ilcCollect(submission, timeout);
+}
+
+ILCSubmission FPGA::ilcSubmit(ILC::ILCBusList &ilc) {
     // no messages to send
     if (ilc.size() == 0) {
-        return;
+        return ILCSubmission();
     }
-    // construct buffer to send
-    std::vector<uint16_t> data;
 
-    uint8_t bus = ilc.getBus();
+    uint32_t irq = getIrq(ilc.getBus());
+    _checkSubmitted(irq, ilc.getBus());
 
-    data.push_back(getTxCommand(bus));
-    data.push_back(0);
-    data.push_back(FIFO::TX_WAIT_TRIGGER);
-    data.push_back(FIFO::TX_TIMESTAMP);
+    _writeILCCommands(ilc);
 
-    for (auto cmd : ilc) {
-        for (auto b : cmd.buffer) {
-            data.push_back(FIFO::TX_MASK | ((static_cast<uint16_t>(b)) << 1));
-        }
-        data.push_back(FIFO::TX_FRAMEEND);
-        data.push_back(cmd.timing > 0x0FFF ? ((0x0FFF & ((cmd.timing / 1000) + 1)) | FIFO::TX_WAIT_LONG_RX)
-                                           : (cmd.timing | FIFO::TX_WAIT_RX));
-    }
+    _submittedIrqs |= irq;
 
-    data.push_back(FIFO::TX_IRQTRIGGER);
-    data[1] = data.size() - 2;
+    return ILCSubmission(&ilc, irq);
+}
 
-    data.push_back(_modbusSoftwareTrigger);
+void FPGA::ilcCollect(ILCSubmission &submission, int32_t timeout) {
+    if (submission.pending() == false) {
+        return;
+    }
 
-    writeCommandFIFO(data.data(), data.size(), 0);
+    auto ilc = submission._ilc;
+    uint32_t irq = submission._irq;
 
-    uint32_t irq = getIrq(bus);
+    submission = ILCSubmission();
+    _submittedIrqs &= ~irq;
 
     bool timedout = false;
 
     waitOnIrqs(irq, timeout, timedout);
     ackIrqs(irq);
 
+    _readILCResponses(*ilc);
+}
+
+void FPGA::ilcCommands(std::vector<ILC::ILCBusList *> ilcs, int32_t timeout) {
+    uint32_t pending = 0;
+
+    for (auto ilc : ilcs) {
+        if (ilc->empty()) {
+            continue;
+        }
+        uint32_t irq = getIrq(ilc->getBus());
+        _checkSubmitted(irq, ilc->getBus());
+        if (pending & irq) {
+            throw std::runtime_error(fmt::format("Bus {} (IRQ 0x{:08x}) used twice in parallel ILC commands.",
+                                                 ilc->getBus(), irq));
+        }
+        pending |= irq;
+    }
+
+    // no messages to send
+    if (pending == 0) {
+        return;
+    }
+
+    // send commands on all busses, so busses are processed in parallel
+    for (auto ilc : ilcs) {
+        if (ilc->empty() == false) {
+            _writeILCCommands(*ilc);
+        }
+    }
+
+    std::exception_ptr error = nullptr;
+
+    auto process = [this, &ilcs, &pending, &error](uint32_t triggered) {
+        for (auto ilc : ilcs) {
+            if (ilc->empty()) {
+                continue;
+            }
+            uint32_t irq = getIrq(ilc->getBus());
+            if ((triggered & pending & irq) == 0) {
+                continue;
+            }
+            ackIrqs(irq);
+            pending &= ~irq;
+            // responses from other busses shall be read from the FIFO even if one bus fails
+            try {
+                _readILCResponses(*ilc);
+            } catch (...) {
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+    while (pending) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= end) {
+            break;
+        }
+
+        bool timedout = false;
+        uint32_t triggered = 0;
+
+        waitOnIrqs(pending, std::chrono::duration_cast<std::chrono::milliseconds>(end - now).count(),
+                   timedout, &triggered);
+        if (timedout) {
+            break;
+        }
+
+        process(triggered);
+    }
+
+    // as in the single bus call, process busses which didn't trigger IRQ
+    // in time - it's most likely a missing response
+    process(pending);
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void FPGA::_checkSubmitted(uint32_t irq, uint8_t bus) {
+    if (_submittedIrqs & irq) {
+        throw std::runtime_error(fmt::format(
+                "Bus {} (IRQ 0x{:08x}) has submitted commands, which weren't collected.", bus, irq));
+    }
+}
+
+void FPGA::_writeILCCommands(ILC::ILCBusList &ilc) {
+    // commands are encoded as they are added to the bus list
+    auto &data = ilc.encodeTx(getTxCommand(ilc.getBus()), _modbusSoftwareTrigger);
+    writeCommandFIFO(data.data(), data.size(), 0);
+}
+
+const uint16_t *FPGA::acquireU16ResponseFIFO(size_t length, uint32_t timeout, size_t &acquired) {
+    // reuses buffer memory, allocates only when a longer response is received
+    _responseCopy.resize(length);
+    readU16ResponseFIFO(_responseCopy.data(), length, timeout);
+    acquired = length;
+    return _responseCopy.data();
+}
+
+void FPGA::_readILCResponses(ILC::ILCBusList &ilc) {
+    uint8_t bus = ilc.getBus();
+
     // get back response
     writeRequestFIFO(getRxCommand(bus), 0);
 
     uint16_t responseLen;
 
     readU16ResponseFIFO(&responseLen, 1, 20);
+
     // minimal response is timestamp + 4 ILC bytes
-    if (responseLen < 8) {
-        if (responseLen > 0) {
-            uint16_t buffer[responseLen];
-            readU16ResponseFIFO(buffer, responseLen, 10);
-        }
-        throw Modbus::MissingResponse(ilc[0].buffer.address(), ilc[0].buffer.func());
+    bool missing = responseLen < 8;
+
+    if (missing == false) {
+        ilc.next_message();
     }
 
-    uint16_t buffer[responseLen];
-    readU16ResponseFIFO(buffer, responseLen, 10);
+    _rxDecoder.reset();
 
-    // response shall follow this format:
-    // 4 bytes (forming uint64_t in low endian) beginning timestamp
-    // data received from ILCs (& 0x9000)
-    // end of frame (0xA000)
-    // 8 bytes of end timestamp (& 0xB000)
-    uint64_t *beginD = reinterpret_cast<uint64_t *>(buffer);
-    uint64_t beginTs = le64toh(*beginD);
-    uint64_t endTs = 0;
-    int endTsShift = 0;
+    // FIFO shall always be fully read, so the next response starts at the
+    // right position. Decode errors are thrown after all elements were released.
+    std::exception_ptr error;
+    size_t remaining = responseLen;
+    while (remaining > 0) {
+        size_t acquired = 0;
+        const uint16_t *elements = acquireU16ResponseFIFO(remaining, 10, acquired);
+        if (acquired == 0 || acquired > remaining) {
+            throw std::runtime_error(
+                    fmt::format("Acquired {} response FIFO elements, expected 1 to {}", acquired, remaining));
+        }
+        if (missing == false && error == nullptr) {
+            try {
+                _rxDecoder.decode(elements, acquired);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        releaseU16ResponseFIFO(acquired);
+        remaining -= acquired;
+    }
 
-    ilc.next_message();
+    if (missing) {
+        ilc.next_message();
+        ilc.endResponses();
+        throw Modbus::MissingResponse(ilc[0].buffer.address(), ilc[0].buffer.func());
+    }
 
-    std::vector<uint8_t> decoded;
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
 
-    int wrong_response_counter = 0;
+    _rxDecoder.finish();
 
-    for (uint16_t *p = buffer + 4; p < buffer + responseLen; p++) {
-        switch (*p & 0xF000) {
-            // data..
-            case FIFO::RX_MASK & 0xF000:
-                decoded.push_back(static_cast<uint8_t>((*p >> 1) & 0xFF));
-                break;
-            case FIFO::RX_TIMESTAMP:
-                if (endTsShift == 64) {
-                    throw std::runtime_error("End timestamp received twice!");
-                }
+    _timingRecorder.startCycle(bus, _rxDecoder.beginTimestamp());
 
-                endTs |= static_cast<uint64_t>((*p) & 0x00FF) << endTsShift;
-                endTsShift += 8;
-                // don't break here - data also ends when timestamp is received
-            case FIFO::RX_ENDFRAME:
-                if (decoded.empty() == false) {
-                    while (true) {
-                        try {
-                            ilc.parse(decoded);
-                            wrong_response_counter = 0;
-                            break;
-                        } catch (Modbus::WrongResponse &wr) {
-                            if (wrong_response_counter == 0) {
-                                SPDLOG_WARN(
-                                        "While processing ILC response, {}. Most likely an ILC is not "
-                                        "responding to commands.",
-                                        wr.what());
-                            }
-                            wrong_response_counter++;
-                            // this most likely means ILC did not respond.
-                        }
-                    }
-                    decoded.clear();
-                    reportTime(beginTs, endTs);
-                    beginTs = endTs;
-                    endTs = 0;
-                    endTsShift = 0;
+    for (size_t i = 0; i < _rxDecoder.frames(); i++) {
+        const uint8_t *decoded = _rxDecoder.data(i);
+        size_t skipped = 0;
+        auto status = ilc.tryParse(_rxDecoder.view(i), &skipped);
+        // frame begin is the previous frame end - latency is known only if the response directly follows
+        // response to the previous command
+        _timingRecorder.record(bus, decoded[0], decoded[1], _rxDecoder[i].begin, _rxDecoder[i].end,
+                               ilc.lastParsedContiguous());
+        if (skipped > 0) {
+            SPDLOG_WARN(
+                    "While processing ILC response from address {}, {} response(s) were missing. "
+                    "Most likely an ILC is not responding to commands.",
+                    decoded[0], skipped);
+        }
+        switch (status) {
+            case Modbus::ParseStatus::OK:
+                // FPGA timestamps are in nanoseconds. Frame following missing response or broadcast includes
+                // the gap, and isn't used to learn reply timing
+                if (ilc.lastParsedContiguous() && _rxDecoder[i].end > _rxDecoder[i].begin) {
+                    ilc.recordLatency(decoded[0], decoded[1],
+                                      (_rxDecoder[i].end - _rxDecoder[i].begin) / 1000);
                 }
                 break;
-            default:
-                throw std::runtime_error(fmt::format("Invalid reply: {0:04x} ({0})", *p));
+            case Modbus::ParseStatus::ERROR_HANDLED:
+                break;
+            case Modbus::ParseStatus::ERROR_RESPONSE:
+                throw Modbus::ErrorResponse(decoded[0], decoded[1]);
+            case Modbus::ParseStatus::UNEXPECTED_RESPONSE:
+                throw Modbus::UnexpectedResponse(decoded[0], decoded[1]);
+            case Modbus::ParseStatus::WRONG_RESPONSE:
+            case Modbus::ParseStatus::NO_COMMAND:
+                SPDLOG_WARN(
+                        "Received response from address {} function {}, which doesn't match any command "
+                        "waiting for response - ignored.",
+                        decoded[0], decoded[1]);
+                break;
         }
+        reportTime(_rxDecoder[i].begin, _rxDecoder[i].end);
     }
 
-    // ilc.checkCommandedEmpty();
+    ilc.endResponses();
 
-    reportTime(beginTs, endTs);
+    // ilc.checkCommandedEmpty();
 }
 
 }  // namespace cRIO
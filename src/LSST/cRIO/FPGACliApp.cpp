@@ -22,6 +22,7 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <iomanip>
 #include <iostream>
 
@@ -65,6 +66,9 @@ FPGACliApp::FPGACliApp(const char* name, const char* description)
 
     addCommand("program-ilc", std::bind(&FPGACliApp::programILC, this, std::placeholders::_1), "FS?",
                NEED_FPGA, "<firmware hex file> <ILC...>", "Program ILC with new firmware.");
+
+    addCommand("timing", std::bind(&FPGACliApp::timing, this, std::placeholders::_1), "s?", NEED_FPGA,
+               "[show|frames|clear|on|off]", "Print ILC response latencies and bus occupancy");
 }
 
 FPGACliApp::~FPGACliApp() {}
@@ -95,6 +99,34 @@ int FPGACliApp::programILC(command_vec cmds) {
     return 0;
 }
 
+int FPGACliApp::timing(command_vec cmds) {
+    auto& recorder = getFPGA()->timingRecorder();
+    std::string action = cmds.empty() ? "show" : cmds[0];
+
+    if (action == "on" || action == "off") {
+        recorder.setEnabled(action == "on");
+    } else if (action == "clear") {
+        recorder.clear();
+    } else if (action == "show" || action == "frames") {
+        auto snapshot = recorder.snapshot();
+        if (action == "frames") {
+            std::cout << "Bus Address Func                Begin                  End" << std::endl;
+            for (auto& f : snapshot.frames) {
+                std::cout << std::setw(3) << static_cast<int>(f.bus) << " " << std::setw(7)
+                          << static_cast<int>(f.address) << " " << std::setw(4) << static_cast<int>(f.func)
+                          << " " << std::setw(20) << f.begin << " " << std::setw(20) << f.end << std::endl;
+            }
+        }
+        std::cout << snapshot;
+    } else {
+        std::cerr << "Unknown timing action: " << action << std::endl;
+        return -1;
+    }
+
+    std::cout << "Timing recording " << (recorder.enabled() ? "enabled" : "disabled") << "." << std::endl;
+    return 0;
+}
+
 void FPGACliApp::addILCCommand(const char* command, std::function<void(ILCUnit)> action, const char* help) {
     bool disableDisabled = strcmp(command, "@enable") == 0;
     addCommand(
@@ -137,6 +169,31 @@ std::shared_ptr<MPU> FPGACliApp::getMPU(std::string name) {
     return ret;
 }
 
+void FPGACliApp::runILCCommands(int32_t timeout) {
+    std::vector<ILC::ILCBusList*> pending;
+    for (auto ilcp : _ilcs) {
+        if (ilcp->empty() == false) {
+            pending.push_back(ilcp.get());
+        }
+    }
+
+    while (pending.empty() == false) {
+        std::vector<ILC::ILCBusList*> round;
+        std::vector<ILC::ILCBusList*> next;
+        std::array<bool, 256> busy{};
+        for (auto ilc : pending) {
+            if (busy[ilc->getBus()]) {
+                next.push_back(ilc);
+                continue;
+            }
+            busy[ilc->getBus()] = true;
+            round.push_back(ilc);
+        }
+        getFPGA()->ilcCommands(round, timeout);
+        pending = std::move(next);
+    }
+}
+
 void FPGACliApp::disableILC(ILCUnit u) {
     _disabledILCs.push_back(u);
     printDisabled();
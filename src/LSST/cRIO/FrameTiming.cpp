@@ -0,0 +1,169 @@
+/*
+ * Records timing of Modbus frames received by FPGA.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <iomanip>
+
+#include <cRIO/FrameTiming.h>
+#include <cRIO/OStreamRestore.h>
+
+using namespace LSST::cRIO;
+
+FrameTimingRecorder::FrameTimingRecorder(size_t frames, size_t window)
+        : _frames(frames), _window(window), _enabled(true) {}
+
+void FrameTimingRecorder::startCycle(uint8_t bus, uint64_t begin) {
+    if (_enabled == false) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto& b = _busses[bus];
+    if (b.cycles > 0 && begin > b.cycleBegin) {
+        b.period = begin - b.cycleBegin;
+        b.busy = b.lastEnd > b.cycleBegin ? b.lastEnd - b.cycleBegin : 0;
+        b.last = static_cast<double>(b.busy) / b.period;
+        b.max = std::max(b.max, b.last);
+    }
+    b.cycles++;
+    b.cycleBegin = begin;
+    b.lastEnd = begin;
+}
+
+void FrameTimingRecorder::record(uint8_t bus, uint8_t address, uint8_t func, uint64_t begin, uint64_t end,
+                                 bool latency) {
+    if (_enabled == false) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto& b = _busses[bus];
+    if (b.frames.empty()) {
+        b.frames.resize(_frames);
+    }
+    b.frames[b.next] = FrameTiming{bus, address, func, begin, end};
+    b.next = (b.next + 1) % _frames;
+    b.count = std::min(b.count + 1, _frames);
+
+    b.lastEnd = std::max(b.lastEnd, end);
+
+    // frame closed without timestamp has end set to 0
+    if (latency == false || end <= begin) {
+        return;
+    }
+
+    auto& w = b.latencies[address];
+    if (w.samples.empty()) {
+        w.samples.resize(_window);
+    }
+    w.samples[w.next] = end - begin;
+    w.next = (w.next + 1) % _window;
+    w.count = std::min(w.count + 1, _window);
+}
+
+TimingSnapshot FrameTimingRecorder::snapshot() const {
+    struct Samples {
+        uint8_t bus;
+        uint8_t address;
+        std::vector<uint64_t> values;
+    };
+
+    TimingSnapshot ret;
+    std::vector<Samples> windows;
+
+    // only copy under the lock, so recording of received frames isn't blocked by sorting
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto& bi : _busses) {
+            auto& b = bi.second;
+            for (size_t i = b.count; i > 0; i--) {
+                ret.frames.push_back(b.frames[(b.next + _frames - i) % _frames]);
+            }
+
+            for (int address = 0; address < 256; address++) {
+                auto w = b.latencies.find(address);
+                if (w == nullptr || w->count == 0) {
+                    continue;
+                }
+                windows.push_back(Samples{bi.first, static_cast<uint8_t>(address),
+                                          std::vector<uint64_t>(w->samples.begin(),
+                                                                w->samples.begin() + w->count)});
+            }
+
+            ret.busses.push_back(BusOccupancy{bi.first, b.cycles, b.busy, b.period, b.last, b.max});
+        }
+    }
+
+    for (auto& w : windows) {
+        auto& sorted = w.values;
+        std::sort(sorted.begin(), sorted.end());
+
+        uint64_t sum = 0;
+        for (auto s : sorted) {
+            sum += s;
+        }
+
+        size_t p99 = (sorted.size() * 99 + 99) / 100 - 1;
+
+        ret.latencies.push_back(LatencyStatistics{w.bus, w.address, sorted.size(), sorted.front(),
+                                                  static_cast<double>(sum) / sorted.size(), sorted[p99],
+                                                  sorted.back()});
+    }
+
+    return ret;
+}
+
+void FrameTimingRecorder::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _busses.clear();
+}
+
+namespace LSST {
+namespace cRIO {
+
+std::ostream& operator<<(std::ostream& os, const TimingSnapshot& snapshot) {
+    OStreamRestore res(os);
+
+    os << "Bus Cycles         Busy       Period   Last%    Max%" << std::endl;
+    for (auto& b : snapshot.busses) {
+        os << std::setw(3) << static_cast<int>(b.bus) << " " << std::setw(6) << b.cycles << " "
+           << std::setw(12) << b.busy << " " << std::setw(12) << b.period << " " << std::fixed
+           << std::setprecision(2) << std::setw(7) << b.last * 100.0 << " " << std::setw(7) << b.max * 100.0
+           << std::endl;
+    }
+
+    os << "Bus Address Samples        Min         Mean          P99          Max" << std::endl;
+    for (auto& l : snapshot.latencies) {
+        os << std::setw(3) << static_cast<int>(l.bus) << " " << std::setw(7) << static_cast<int>(l.address)
+           << " " << std::setw(7) << l.samples << " " << std::setw(10) << l.min << " " << std::fixed
+           << std::setprecision(1) << std::setw(12) << l.mean << " " << std::setw(12) << l.p99 << " "
+           << std::setw(12) << l.max << std::endl;
+    }
+
+    return os;
+}
+
+}  // namespace cRIO
+}  // namespace LSST
@@ -0,0 +1,69 @@
+/*
+ * Lock-free multiple producers, single consumer queue.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <climits>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cRIO/IngressQueue.h>
+
+using namespace LSST::cRIO;
+
+static long futex(std::atomic<uint32_t>* address, int op, uint32_t value, const struct timespec* timeout,
+                  uint32_t mask) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), op | FUTEX_PRIVATE_FLAG, value, timeout,
+                   nullptr, mask);
+}
+
+void WakeSignal::notify() {
+    _sequence.fetch_add(1, std::memory_order_seq_cst);
+    // skip syscall if nobody waits
+    if (_waiting.load(std::memory_order_seq_cst) > 0) {
+        futex(&_sequence, FUTEX_WAKE, INT_MAX, nullptr, 0);
+    }
+}
+
+void WakeSignal::wait(uint32_t sequence) {
+    _waiting.fetch_add(1, std::memory_order_seq_cst);
+    while (_sequence.load(std::memory_order_seq_cst) == sequence) {
+        futex(&_sequence, FUTEX_WAIT_BITSET, sequence, nullptr, FUTEX_BITSET_MATCH_ANY);
+    }
+    _waiting.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void WakeSignal::wait_until(uint32_t sequence, std::chrono::steady_clock::time_point abs_time) {
+    // steady_clock is CLOCK_MONOTONIC, used by FUTEX_WAIT_BITSET absolute timeout
+    auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(abs_time.time_since_epoch());
+    struct timespec timeout;
+    timeout.tv_sec = since_epoch.count() / 1000000000;
+    timeout.tv_nsec = since_epoch.count() % 1000000000;
+
+    _waiting.fetch_add(1, std::memory_order_seq_cst);
+    while (_sequence.load(std::memory_order_seq_cst) == sequence &&
+           std::chrono::steady_clock::now() < abs_time) {
+        futex(&_sequence, FUTEX_WAIT_BITSET, sequence, &timeout, FUTEX_BITSET_MATCH_ANY);
+    }
+    _waiting.fetch_sub(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,52 @@
+/*
+ * Lock-free ring of triggered interrupt masks.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cRIO/InterruptRing.h>
+
+using namespace LSST::cRIO;
+
+bool InterruptRing::push(uint32_t mask) {
+    auto tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head.load(std::memory_order_acquire) >= CAPACITY) {
+        _overflow.fetch_or(mask, std::memory_order_release);
+        return false;
+    }
+    _masks[tail % CAPACITY] = mask;
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+uint32_t InterruptRing::drain() {
+    auto head = _head.load(std::memory_order_relaxed);
+    auto tail = _tail.load(std::memory_order_acquire);
+    uint32_t ret = 0;
+    for (; head != tail; head++) {
+        ret |= _masks[head % CAPACITY];
+    }
+    _head.store(head, std::memory_order_release);
+    return ret | _overflow.exchange(0, std::memory_order_acquire);
+}
+
+bool InterruptRing::empty() const {
+    return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire) &&
+           _overflow.load(std::memory_order_acquire) == 0;
+}
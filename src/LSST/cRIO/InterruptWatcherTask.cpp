@@ -20,8 +20,6 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <memory>
-
 #include <cRIO/ControllerThread.h>
 #include <cRIO/InterruptWatcherTask.h>
 
@@ -33,8 +31,7 @@ void InterruptWatcherThread::run(std::unique_lock<std::mutex>& lock) {
         bool timedout = false;
         _fpga->waitOnIrqs(0xFFFFFFFF, 20, timedout, &_triggeredInterrupts);
         if (timedout == false) {
-            ControllerThread::instance().enqueue(
-                    std::make_shared<InterruptWatcherTask>(_triggeredInterrupts));
+            ControllerThread::instance().signalInterrupts(_triggeredInterrupts);
         }
         lock.lock();
     }
@@ -26,11 +26,18 @@
 #include <cRIO/CliApp.h>
 #include <cRIO/MPU.h>
 #include <Modbus/Parser.h>
+#include <Modbus/Reply.h>
 
 using namespace LSST::cRIO;
 
+// register address and value (or number of registers) written
+typedef Modbus::Reply<uint16_t, uint16_t> PresetReply;
+
+// error code
+typedef Modbus::Reply<uint8_t> ErrorReply;
+
 MPU::MPU(uint8_t node_address) : _bus(0), _node_address(node_address) {
-    add_response(READ_INPUT_STATUS, [this](Modbus::Parser parser) {
+    add_response(READ_INPUT_STATUS, [this](Modbus::ParserView &parser) {
         auto commanded = _commanded_info.front();
         _commanded_info.pop_front();
 
@@ -57,7 +64,7 @@ MPU::MPU(uint8_t node_address) : _bus(0), _node_address(node_address) {
         parser.checkCRC();
     });
 
-    add_response(READ_HOLDING_REGISTERS, [this](Modbus::Parser parser) {
+    add_response(READ_HOLDING_REGISTERS, [this](Modbus::ParserView &parser) {
         auto commanded = _commanded_info.front();
         _commanded_info.pop_front();
 
@@ -76,7 +83,7 @@ MPU::MPU(uint8_t node_address) : _bus(0), _node_address(node_address) {
         parser.checkCRC();
     });
 
-    add_response(PRESET_HOLDING_REGISTER, [this](Modbus::Parser parser) {
+    add_response(PRESET_HOLDING_REGISTER, [this](Modbus::ParserView &parser) {
         auto commanded = _commanded_info.front();
         _commanded_info.pop_front();
 
@@ -84,8 +91,7 @@ MPU::MPU(uint8_t node_address) : _bus(0), _node_address(node_address) {
             throw std::runtime_error(
                     fmt::format("Invalid ModBus address {}, expected {}", parser.address(), _node_address));
         }
-        uint16_t reg = parser.read<uint16_t>();
-        uint16_t value = parser.read<uint16_t>();
+        auto [reg, value] = PresetReply::parse(parser);
         if (reg != commanded.address) {
             throw std::runtime_error(
                     fmt::format("Invalid register {:04x}, expected {:04x}", reg, commanded.address));
@@ -94,10 +100,9 @@ MPU::MPU(uint8_t node_address) : _bus(0), _node_address(node_address) {
             std::lock_guard<std::mutex> lg(_registerMutex);
             _registers[commanded.address] = value;
         }
-        parser.checkCRC();
     });
 
-    add_response(PRESET_HOLDING_REGISTERS, [this](Modbus::Parser parser) {
+    add_response(PRESET_HOLDING_REGISTERS, [this](Modbus::ParserView &parser) {
         auto commanded = _commanded_info.front();
         _commanded_info.pop_front();
 
@@ -105,8 +110,7 @@ MPU::MPU(uint8_t node_address) : _bus(0), _node_address(node_address) {
             throw std::runtime_error(
                     fmt::format("Invalid ModBus address {}, expected {}", parser.address(), _node_address));
         }
-        uint16_t reg = parser.read<uint16_t>();
-        uint16_t len = parser.read<uint16_t>();
+        auto [reg, len] = PresetReply::parse(parser);
         if (reg != commanded.address) {
             throw std::runtime_error(
                     fmt::format("Invalid register {:04x}, expected {:04x}", reg, commanded.address));
@@ -115,7 +119,6 @@ MPU::MPU(uint8_t node_address) : _bus(0), _node_address(node_address) {
             throw std::runtime_error(fmt::format("Invalid length - register {:04x}, length {}, expected {}",
                                                  reg, len, commanded.length));
         }
-        parser.checkCRC();
     });
 }
 
@@ -135,11 +138,11 @@ int MPU::responseLength(const std::vector<uint8_t> &response) {
 
         case PRESET_HOLDING_REGISTER:
         case PRESET_HOLDING_REGISTERS:
-            return 8;
+            return PresetReply::LENGTH;
 
         default:
             if ((response[1] & 0x80) == 0x80) {
-                return 5;
+                return ErrorReply::LENGTH;
             }
             throw std::runtime_error(fmt::format("Invalid function for responseLength: {}", response[1]));
     }
@@ -180,9 +180,9 @@ void ModbusBuffer::checkCommandedEmpty() {
 
 void ModbusBuffer::addResponse(uint8_t func, std::function<void(uint8_t)> action, uint8_t errorResponse,
                                std::function<void(uint8_t, uint8_t)> errorAction) {
-    _actions[func] = action;
-    _errorActions[errorResponse] =
-            std::pair<uint8_t, std::function<void(uint8_t, uint8_t)>>(func, errorAction);
+    _actions.set(func, action);
+    _errorActions.set(errorResponse,
+                      std::pair<uint8_t, std::function<void(uint8_t, uint8_t)>>(func, errorAction));
 }
 
 void ModbusBuffer::processResponse(uint16_t* response, size_t length) {
@@ -196,27 +196,26 @@ void ModbusBuffer::processResponse(uint16_t* response, size_t length) {
 
         // either function response was received, or error response. For error
         // response, check if the function for which it is used was called.
-        if (_errorActions.find(func) == _errorActions.end()) {
+        auto errorAction = _errorActions.find(func);
+        if (errorAction == nullptr) {
             checkCommanded(address, func);
         } else {
-            checkCommanded(address, _errorActions[func].first);
+            checkCommanded(address, errorAction->first);
         }
 
-        try {
-            _actions.at(func)(address);
-        } catch (std::out_of_range& _ex) {
-            try {
-                auto errorAction = _errorActions.at(func);
-                uint8_t exception = read<uint8_t>();
-                checkCRC();
-                if (errorAction.second) {
-                    errorAction.second(address, exception);
-                } else {
-                    throw Exception(address, func, exception);
-                }
-            } catch (std::out_of_range& _ex2) {
-                throw UnknownResponse(address, func);
+        auto action = _actions.find(func);
+        if (action != nullptr) {
+            (*action)(address);
+        } else if (errorAction != nullptr) {
+            uint8_t exception = read<uint8_t>();
+            checkCRC();
+            if (errorAction->second) {
+                errorAction->second(address, exception);
+            } else {
+                throw Exception(address, func, exception);
             }
+        } else {
+            throw UnknownResponse(address, func);
         }
     }
 
@@ -232,18 +231,6 @@ ModbusBuffer::Exception::Exception(uint8_t address, uint8_t func, uint8_t except
                   "ModBus Exception {2} (ModBus address {0}, ModBus response function {1} (0x{1:02x})).",
                   address, func, exception)) {}
 
-void ModbusBuffer::CRC::add(uint8_t data) {
-    _crcCounter = _crcCounter ^ (uint16_t(data));
-    for (int j = 0; j < 8; j++) {
-        if (_crcCounter & 0x0001) {
-            _crcCounter = _crcCounter >> 1;
-            _crcCounter = _crcCounter ^ 0xA001;
-        } else {
-            _crcCounter = _crcCounter >> 1;
-        }
-    }
-}
-
 ModbusBuffer::CRCError::CRCError(uint16_t calculated, uint16_t received)
         : std::runtime_error(fmt::format("checkCRC invalid CRC - expected 0x{:04x}, got 0x{:04x}.",
                                          calculated, received)) {}
@@ -0,0 +1,67 @@
+/*
+ * Periodic task scheduled against its deadlines.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+
+#include <cRIO/PeriodicTask.h>
+
+using namespace LSST::cRIO;
+
+PeriodicTask::PeriodicTask(std::chrono::microseconds period, MissedPolicy policy)
+        : _period(period), _policy(policy) {
+    if (_period <= std::chrono::microseconds::zero()) {
+        throw std::invalid_argument("PeriodicTask: period must be positive");
+    }
+}
+
+task_return_t PeriodicTask::run() {
+    _started = std::chrono::steady_clock::now();
+    _activations++;
+    return runPeriod() ? 0 : Task::DONT_RESCHEDULE;
+}
+
+std::chrono::steady_clock::time_point PeriodicTask::nextRun(std::chrono::steady_clock::time_point deadline,
+                                                            std::chrono::steady_clock::time_point now,
+                                                            task_return_t wait) {
+    int64_t lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(_started - deadline).count();
+    _lastLateness = lateness;
+    if (lateness > _maxLateness) {
+        _maxLateness = lateness;
+    }
+
+    auto next = deadline + _period;
+    if (next > now || _policy == MissedPolicy::CATCH_UP) {
+        return next;
+    }
+
+    // keep the period grid - skip to the first deadline in the future
+    auto missed = (now - next) / _period + 1;
+    _skipped += missed;
+    return next + missed * _period;
+}
+
+void PeriodicTask::resetStatistics() {
+    _lastLateness = 0;
+    _maxLateness = 0;
+    _activations = 0;
+    _skipped = 0;
+}
@@ -32,16 +32,21 @@
 using namespace LSST::cRIO;
 
 PrintILC::PrintILC(uint8_t bus) : ILCBusList(bus), _printout(0), _lastAddress(0) {
+    addResponseLength(ILC_CLI_CMD::WRITE_APPLICATION_STATS, 4);
+    addResponseLength(ILC_CLI_CMD::ERASE_APPLICATION, 4);
+    addResponseLength(ILC_CLI_CMD::WRITE_APPLICATION_PAGE, 4);
+    addResponseLength(ILC_CLI_CMD::WRITE_VERIFY_APPLICATION, 6);
+
     add_response(ILC_CLI_CMD::WRITE_APPLICATION_STATS,
-                 [this](Modbus::Parser parser) { processWriteApplicationStats(parser.address()); });
+                 [this](Modbus::ParserView &parser) { processWriteApplicationStats(parser.address()); });
 
     add_response(ILC_CLI_CMD::ERASE_APPLICATION,
-                 [this](Modbus::Parser parser) { processEraseILCApplication(parser.address()); });
+                 [this](Modbus::ParserView &parser) { processEraseILCApplication(parser.address()); });
 
     add_response(ILC_CLI_CMD::WRITE_APPLICATION_PAGE,
-                 [this](Modbus::Parser parser) { processWriteApplicationPage(parser.address()); });
+                 [this](Modbus::ParserView &parser) { processWriteApplicationPage(parser.address()); });
 
-    add_response(ILC_CLI_CMD::WRITE_VERIFY_APPLICATION, [this](Modbus::Parser parser) {
+    add_response(ILC_CLI_CMD::WRITE_VERIFY_APPLICATION, [this](Modbus::ParserView &parser) {
         uint16_t status = parser.read<uint16_t>();
         processVerifyUserApplication(parser.address(), status);
     });
@@ -276,9 +281,7 @@ void PrintILC::_writeHex(FPGA *fpga, uint8_t address, IntelHex &hex) {
     }
 
     // CRC is calculated only from data, skips filling
-    for (auto d : data) {
-        _crc.add(d);
-    }
+    _crc.update(data.data(), data.size());
 
     std::cout << "Writing pages ";
 
@@ -18,20 +18,127 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <stdexcept>
+
+#include <spdlog/fmt/fmt.h>
+
 #include "cRIO/TaskQueue.h"
 
 using namespace LSST::cRIO;
 
+std::atomic<task_handle_t> TaskQueue::_nextHandle(1);
+
+task_handle_t TaskQueue::push(const TaskEntry &entry) {
+    Node node{entry, _order++};
+    if (node.entry.handle == 0) {
+        node.entry.handle = newHandle();
+    }
+    if (_index.emplace(node.entry.handle, _heap.size()).second == false) {
+        throw std::runtime_error(fmt::format("Task with handle {} is already queued", node.entry.handle));
+    }
+    _heap.push_back(std::move(node));
+    auto handle = _heap.back().entry.handle;
+    _siftUp(_heap.size() - 1);
+    return handle;
+}
+
+bool TaskQueue::cancel(task_handle_t handle) {
+    auto it = _index.find(handle);
+    if (it == _index.end()) {
+        return false;
+    }
+    _erase(it->second);
+    return true;
+}
+
+bool TaskQueue::reschedule(task_handle_t handle, std::chrono::steady_clock::time_point when) {
+    auto it = _index.find(handle);
+    if (it == _index.end()) {
+        return false;
+    }
+    auto &node = _heap[it->second];
+    node.entry.first = when;
+    node.order = _order++;
+    _place(it->second);
+    return true;
+}
+
 bool TaskQueue::remove(std::shared_ptr<Task> what) {
-    bool removed = false;
-    auto iter = c.begin();
-    while (iter != c.end()) {
-        if (iter->second.get() == what.get()) {
-            iter = c.erase(iter);
-            removed = true;
-        } else {
-            iter++;
+    std::vector<task_handle_t> handles;
+    for (auto &node : _heap) {
+        if (node.entry.second.get() == what.get()) {
+            handles.push_back(node.entry.handle);
+        }
+    }
+    for (auto handle : handles) {
+        cancel(handle);
+    }
+    return handles.empty() == false;
+}
+
+void TaskQueue::clear() {
+    _heap.clear();
+    _index.clear();
+}
+
+void TaskQueue::_erase(size_t pos) {
+    _index.erase(_heap[pos].entry.handle);
+    size_t last = _heap.size() - 1;
+    if (pos != last) {
+        _move(pos, std::move(_heap[last]));
+        _heap.pop_back();
+        _place(pos);
+    } else {
+        _heap.pop_back();
+    }
+}
+
+void TaskQueue::_place(size_t pos) {
+    if (_siftUp(pos) == pos) {
+        _siftDown(pos);
+    }
+}
+
+size_t TaskQueue::_siftUp(size_t pos) {
+    Node node = std::move(_heap[pos]);
+    while (pos > 0) {
+        size_t parent = (pos - 1) / ARITY;
+        if (_before(node, _heap[parent]) == false) {
+            break;
         }
+        _move(pos, std::move(_heap[parent]));
+        pos = parent;
     }
-    return removed;
+    _move(pos, std::move(node));
+    return pos;
+}
+
+size_t TaskQueue::_siftDown(size_t pos) {
+    Node node = std::move(_heap[pos]);
+    while (true) {
+        size_t first = pos * ARITY + 1;
+        if (first >= _heap.size()) {
+            break;
+        }
+        size_t best = first;
+        size_t end = std::min(first + ARITY, _heap.size());
+        for (size_t child = first + 1; child < end; child++) {
+            if (_before(_heap[child], _heap[best])) {
+                best = child;
+            }
+        }
+        if (_before(_heap[best], node) == false) {
+            break;
+        }
+        _move(pos, std::move(_heap[best]));
+        pos = best;
+    }
+    _move(pos, std::move(node));
+    return pos;
+}
+
+void TaskQueue::_move(size_t to, Node &&node) {
+    _index[node.entry.handle] = to;
+    _heap[to] = std::move(node);
 }
@@ -20,34 +20,30 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <array>
+
 #include <cRIO/ThermalILC.h>
 
 using namespace LSST::cRIO;
 
 ThermalILC::ThermalILC(uint8_t bus) : ILC::ILCBusList(bus) {
-    auto thermalStatus = [this](Modbus::Parser parser) {
-        uint8_t status = parser.read<uint8_t>();
-        float differentialTemperature = parser.read<float>();
-        uint8_t fanRPM = parser.read<uint8_t>();
-        float absoluteTemperature = parser.read<float>();
-        parser.checkCRC();
-        processThermalStatus(parser.address(), status, differentialTemperature, fanRPM, absoluteTemperature);
-    };
+    typedef Modbus::Reply<uint8_t, float, uint8_t, float> ThermalStatusReply;
 
-    auto reheaterGains = [this](Modbus::Parser parser) {
-        float proportionalGain = parser.read<float>();
-        float integralGain = parser.read<float>();
-        parser.checkCRC();
-        processReHeaterGains(parser.address(), proportionalGain, integralGain);
+    auto thermalStatus = [this](uint8_t address, uint8_t status, float differentialTemperature, uint8_t fanRPM,
+                                float absoluteTemperature) {
+        processThermalStatus(address, status, differentialTemperature, fanRPM, absoluteTemperature);
     };
 
-    add_response(ILC_THERMAL_CMD::SET_THERMAL_DEMAND, thermalStatus);
+    addReply<ThermalStatusReply>(ILC_THERMAL_CMD::SET_THERMAL_DEMAND, thermalStatus);
 
-    add_response(ILC_THERMAL_CMD::REPORT_THERMAL_STATUS, thermalStatus);
+    addReply<ThermalStatusReply>(ILC_THERMAL_CMD::REPORT_THERMAL_STATUS, thermalStatus);
 
-    add_response(ILC_THERMAL_CMD::SET_REHEATER_GAINS, [this](Modbus::Parser parser) { parser.checkCRC(); });
+    addReply<Modbus::Reply<>>(ILC_THERMAL_CMD::SET_REHEATER_GAINS, [](uint8_t address) {});
 
-    add_response(ILC_THERMAL_CMD::REPORT_REHEATER_GAINS, reheaterGains);
+    addReply<Modbus::Reply<float, float>>(ILC_THERMAL_CMD::REPORT_REHEATER_GAINS,
+                                          [this](uint8_t address, float proportionalGain, float integralGain) {
+                                              processReHeaterGains(address, proportionalGain, integralGain);
+                                          });
 }
 
 std::vector<const char*> ThermalILC::getStatusString(uint16_t status) {
@@ -97,7 +93,7 @@ std::vector<const char*> ThermalILC::getThermalStatusString(uint8_t status) {
 }
 
 void ThermalILC::broadcastThermalDemand(uint8_t heaterPWM[NUM_TS_ILC], uint8_t fanRPM[NUM_TS_ILC]) {
-    std::vector<uint8_t> params(NUM_TS_ILC * 2);
+    std::array<uint8_t, NUM_TS_ILC * 2> params;
     for (int i = 0, o = 0; i < NUM_TS_ILC; i++, o++) {
         params[o] = heaterPWM[i];
         o++;
@@ -106,3 +102,11 @@ void ThermalILC::broadcastThermalDemand(uint8_t heaterPWM[NUM_TS_ILC], uint8_t f
 
     broadcastFunction(250, 88, 450, nextBroadcastCounter(), params);
 }
+
+ILC::BroadcastCoalescer ThermalILC::thermalDemandCoalescer(size_t threshold) {
+    std::vector<uint8_t> addresses;
+    for (int i = 1; i <= NUM_TS_ILC; i++) {
+        addresses.push_back(i);
+    }
+    return ILC::BroadcastCoalescer(ILC_THERMAL_CMD::SET_THERMAL_DEMAND, 500, 250, 450, addresses, 2, threshold);
+}
@@ -18,8 +18,11 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <cstring>
 #include <stdexcept>
 
+#include <spdlog/spdlog.h>
+
 #include <cRIO/Thread.h>
 
 using namespace std::chrono_literals;
@@ -35,7 +38,25 @@ void Thread::start(std::chrono::microseconds timeout) {
             throw std::runtime_error("Thread: Cannot run a thread twice!");
         }
         keepRunning = true;
-        _thread = new std::thread(&Thread::_run, this);
+
+        _attributes.lockProcessMemory();
+
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if (_attributes.stackSize > 0) {
+            int err = pthread_attr_setstacksize(&attr, _attributes.stackSize);
+            if (err != 0) {
+                SPDLOG_WARN("Thread: cannot set stack size to {}: {}", _attributes.stackSize, strerror(err));
+            }
+        }
+        _thread = new pthread_t;
+        int err = pthread_create(_thread, &attr, &Thread::_start_routine, this);
+        pthread_attr_destroy(&attr);
+        if (err != 0) {
+            delete _thread;
+            _thread = nullptr;
+            throw std::runtime_error(fmt::format("Thread: Cannot create thread: {}", strerror(err)));
+        }
         if (_startCondition.wait_for(lg, timeout, [this]() { return _threadStarted == true; }) == false) {
             throw std::runtime_error("Thread: Was not started!");
         }
@@ -48,6 +69,7 @@ void Thread::stop(std::chrono::microseconds timeout) {
         keepRunning = false;
     }
     runCondition.notify_one();
+    wakeUp();
     {
         std::unique_lock<std::mutex> lg(runMutex);
         if (_thread) {
@@ -55,7 +77,7 @@ void Thread::stop(std::chrono::microseconds timeout) {
                 false) {
                 throw std::runtime_error("Thread: Cannot stop thread!");
             }
-            _thread->join();
+            pthread_join(*_thread, nullptr);
             delete _thread;
             _thread = NULL;
         }
@@ -64,8 +86,17 @@ void Thread::stop(std::chrono::microseconds timeout) {
 
 bool Thread::joinable() {
     std::lock_guard<std::mutex> lg(runMutex);
-    if (_thread == nullptr) return false;
-    return _thread->joinable();
+    return _thread != nullptr;
+}
+
+void Thread::setAttributes(const ThreadAttributes& attributes) {
+    std::lock_guard<std::mutex> lg(runMutex);
+    _attributes = attributes;
+}
+
+ThreadAttributes Thread::getAttributes() {
+    std::lock_guard<std::mutex> lg(runMutex);
+    return _attributes;
 }
 
 bool Thread::isRunning() {
@@ -78,7 +109,16 @@ bool Thread::wait_until(const std::chrono::time_point<std::chrono::steady_clock>
     return (runCondition.wait_until(lg, abs_time, [this] { return keepRunning == true; }));
 }
 
+void* Thread::_start_routine(void* thread) {
+    static_cast<Thread*>(thread)->_run();
+    return nullptr;
+}
+
 void Thread::_run() {
+    auto attributes = getAttributes();
+    if (attributes.empty() == false) {
+        attributes.applyToCurrentThread();
+    }
     {
         std::unique_lock<std::mutex> lock(runMutex);
         _threadStarted = true;
@@ -0,0 +1,120 @@
+/*
+ * Real-time attributes of threads.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <alloca.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include <cRIO/ThreadAttributes.h>
+
+using namespace LSST::cRIO;
+
+// stack left untouched by prefault, for the frames of the prefaulting code
+static constexpr size_t PREFAULT_RESERVE = 64 * 1024;
+
+static std::atomic<bool> _memoryLocked = false;
+
+// separate non-inlined function, so the allocated stack is released on return
+static void __attribute__((noinline)) _prefault(size_t size) {
+    volatile char *stack = static_cast<volatile char *>(alloca(size));
+    size_t page = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < size; i += page) {
+        stack[i] = 0;
+    }
+}
+
+bool ThreadAttributes::empty() const {
+    return policy == SCHED_OTHER && priority == 0 && cpus.empty() && stackSize == 0 && stackPrefault == 0 &&
+           lockMemory == false;
+}
+
+bool ThreadAttributes::lockProcessMemory() const {
+    if (lockMemory == false || _memoryLocked) {
+        return true;
+    }
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        SPDLOG_WARN("Cannot lock process memory: {}", strerror(errno));
+        return false;
+    }
+    _memoryLocked = true;
+    return true;
+}
+
+bool ThreadAttributes::applyToCurrentThread(const char *name) const {
+    bool ret = true;
+
+    if (policy != SCHED_OTHER || priority != 0) {
+        struct sched_param param;
+        param.sched_priority = priority;
+        int err = pthread_setschedparam(pthread_self(), policy, &param);
+        if (err != 0) {
+            SPDLOG_WARN("Cannot set {} scheduling policy {} priority {}: {}{}", name, policy, priority,
+                        strerror(err), err == EPERM ? " - missing real-time privileges?" : "");
+            ret = false;
+        }
+    }
+
+    if (cpus.empty() == false) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (auto cpu : cpus) {
+            if (cpu < 0 || cpu >= CPU_SETSIZE) {
+                SPDLOG_WARN("Invalid {} CPU {}", name, cpu);
+                continue;
+            }
+            CPU_SET(cpu, &set);
+        }
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (err != 0) {
+            SPDLOG_WARN("Cannot set {} CPU affinity: {}", name, strerror(err));
+            ret = false;
+        }
+    }
+
+    if (stackPrefault > 0) {
+        size_t available = 0;
+        pthread_attr_t attr;
+        if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+            pthread_attr_getstacksize(&attr, &available);
+            pthread_attr_destroy(&attr);
+        }
+        size_t size = stackPrefault;
+        if (size + PREFAULT_RESERVE > available) {
+            size = available > PREFAULT_RESERVE ? available - PREFAULT_RESERVE : 0;
+            SPDLOG_WARN("Cannot prefault {} bytes of {} stack - stack size is {}, prefaulting {} bytes",
+                        stackPrefault, name, available, size);
+            ret = false;
+        }
+        if (size > 0) {
+            _prefault(size);
+        }
+    }
+
+    return ret;
+}
@@ -0,0 +1,250 @@
+/*
+ * Pool of worker threads running jobs serialized by keys.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+#include <cRIO/WorkerPool.h>
+
+using namespace LSST::cRIO;
+
+// pool and index of the worker running on the current thread
+static thread_local WorkerPool *_currentPool = nullptr;
+static thread_local size_t _currentWorker = 0;
+
+WorkerPool::WorkerPool(size_t workers) {
+    if (workers == 0) {
+        throw std::invalid_argument("WorkerPool: at least one worker is needed");
+    }
+    for (size_t i = 0; i < workers; i++) {
+        _workers.emplace_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workers; i++) {
+        _workers[i]->thread = std::thread(&WorkerPool::_run, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lg(_sleepMutex);
+        _stopping = true;
+    }
+    _sleepCondition.notify_all();
+    for (auto &worker : _workers) {
+        worker->thread.join();
+    }
+}
+
+void WorkerPool::submit(task_key_t key, job_t job) {
+    _pendingJobs++;
+
+    std::shared_ptr<Strand> strand;
+    {
+        std::lock_guard<std::mutex> lg(_strandsMutex);
+        auto it = _strands.find(key);
+        if (it != _strands.end()) {
+            it->second->jobs.push_back(std::move(job));
+            // strand is queued or running, will be rescheduled after the running job
+            if (it->second->scheduled) {
+                return;
+            }
+            // idle strand with signal
+            strand = it->second;
+            strand->scheduled = true;
+        } else {
+            strand = std::make_shared<Strand>(key);
+            strand->jobs.push_back(std::move(job));
+            _strands.emplace(key, strand);
+        }
+    }
+
+    _schedule(strand);
+}
+
+void WorkerPool::addSignal(task_key_t key, job_t job) {
+    {
+        std::lock_guard<std::mutex> lg(_signalledMutex);
+        _signalled.reserve(++_signalCount);
+    }
+
+    std::lock_guard<std::mutex> lg(_strandsMutex);
+    auto &strand = _strands[key];
+    if (strand == nullptr) {
+        strand = std::make_shared<Strand>(key);
+        strand->scheduled = false;
+    } else if (strand->signalJob) {
+        throw std::runtime_error(fmt::format("WorkerPool: signal for key {} already added", key));
+    }
+    strand->signalJob = std::move(job);
+}
+
+void WorkerPool::signal(task_key_t key) {
+    std::shared_ptr<Strand> strand;
+    {
+        std::lock_guard<std::mutex> lg(_strandsMutex);
+        auto it = _strands.find(key);
+        if (it == _strands.end() || !it->second->signalJob) {
+            throw std::out_of_range(fmt::format("WorkerPool: signal for key {} wasn't added", key));
+        }
+        if (it->second->signalled) {
+            return;
+        }
+        _pendingJobs++;
+        it->second->signalled = true;
+        if (it->second->scheduled) {
+            return;
+        }
+        strand = it->second;
+        strand->scheduled = true;
+    }
+
+    _schedule(strand);
+}
+
+void WorkerPool::_run(size_t index) {
+    _currentPool = this;
+    _currentWorker = index;
+
+    while (true) {
+        auto strand = _take(index);
+        if (strand) {
+            _runStrand(strand);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        // strand was queued, but not yet taken by other worker
+        if (_queued > 0) {
+            continue;
+        }
+        if (_stopping) {
+            break;
+        }
+        _sleepCondition.wait(lock, [this]() { return _queued > 0 || _stopping; });
+    }
+
+    _currentPool = nullptr;
+}
+
+void WorkerPool::_schedule(std::shared_ptr<Strand> strand, bool requeue) {
+    // count the strand before it is published, so a stealing worker can't decrement _queued before it is
+    // incremented. Workers seeing _queued > 0 retry _take until the strand is pushed
+    {
+        std::lock_guard<std::mutex> lg(_sleepMutex);
+        _queued++;
+    }
+
+    if (strand->signalJob) {
+        // capacity for all strands with signal is reserved in addSignal
+        std::lock_guard<std::mutex> lg(_signalledMutex);
+        _signalled.push_back(strand);
+    } else if (_currentPool == this) {
+        // owner takes strands from back - submitted strand is run next, while requeued strand waits
+        // behind strands already queued
+        auto &worker = *_workers[_currentWorker];
+        std::lock_guard<std::mutex> lg(worker.mutex);
+        if (requeue) {
+            worker.strands.push_front(strand);
+        } else {
+            worker.strands.push_back(strand);
+        }
+    } else {
+        auto &worker = *_workers[_nextWorker++ % _workers.size()];
+        std::lock_guard<std::mutex> lg(worker.mutex);
+        worker.strands.push_back(strand);
+    }
+
+    _sleepCondition.notify_one();
+}
+
+std::shared_ptr<WorkerPool::Strand> WorkerPool::_take(size_t index) {
+    std::shared_ptr<Strand> ret;
+    {
+        std::lock_guard<std::mutex> lg(_signalledMutex);
+        if (_signalled.empty() == false) {
+            ret = std::move(_signalled.front());
+            _signalled.erase(_signalled.begin());
+            _queued--;
+            return ret;
+        }
+    }
+
+    for (size_t i = 0; i < _workers.size(); i++) {
+        auto &worker = *_workers[(index + i) % _workers.size()];
+        std::lock_guard<std::mutex> lg(worker.mutex);
+        if (worker.strands.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            ret = worker.strands.back();
+            worker.strands.pop_back();
+        } else {
+            // steal the oldest strand
+            ret = worker.strands.front();
+            worker.strands.pop_front();
+        }
+        _queued--;
+        break;
+    }
+    return ret;
+}
+
+void WorkerPool::_runStrand(std::shared_ptr<Strand> strand) {
+    job_t job;
+    bool signalled;
+    {
+        std::lock_guard<std::mutex> lg(_strandsMutex);
+        signalled = strand->signalled;
+        if (signalled) {
+            strand->signalled = false;
+        } else {
+            job = std::move(strand->jobs.front());
+            strand->jobs.pop_front();
+        }
+    }
+
+    try {
+        // signal job isn't modified after addSignal, and strand runs on a single worker
+        if (signalled) {
+            strand->signalJob();
+        } else {
+            job();
+        }
+    } catch (std::exception &ex) {
+        SPDLOG_ERROR("WorkerPool: job with key {} failed: {}", strand->key, ex.what());
+    }
+    _pendingJobs--;
+
+    {
+        std::lock_guard<std::mutex> lg(_strandsMutex);
+        if (strand->jobs.empty() && strand->signalled == false) {
+            if (strand->signalJob) {
+                strand->scheduled = false;
+            } else {
+                _strands.erase(strand->key);
+            }
+            return;
+        }
+    }
+    _schedule(strand, true);
+}
@@ -0,0 +1,142 @@
+/*
+ * Adaptive Modbus reply timing.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <Modbus/AdaptiveTiming.h>
+
+using namespace Modbus;
+
+AdaptiveTiming::AdaptiveTiming(uint32_t margin, uint32_t minSamples)
+        : _margin(margin), _minSamples(minSamples) {}
+
+AdaptiveTiming::AdaptiveTiming(const AdaptiveTiming &other)
+        : _margin(other._margin), _minSamples(other._minSamples) {
+    _copyHistograms(other);
+}
+
+AdaptiveTiming &AdaptiveTiming::operator=(const AdaptiveTiming &other) {
+    if (this != &other) {
+        _margin = other._margin;
+        _minSamples = other._minSamples;
+        clear();
+        _copyHistograms(other);
+    }
+    return *this;
+}
+
+void AdaptiveTiming::record(uint8_t address, uint8_t func, uint32_t latency) {
+    auto &addresses = _histograms[func];
+    if (addresses == nullptr) {
+        addresses = std::make_unique<AddressHistograms>();
+    }
+    auto &histogram = (*addresses)[address];
+    if (histogram == nullptr) {
+        histogram = std::make_unique<Histogram>();
+    }
+    auto &h = *histogram;
+
+    if (h.samples >= DECAY_LIMIT) {
+        h.samples = 0;
+        for (auto &c : h.counts) {
+            c /= 2;
+            h.samples += c;
+        }
+    }
+
+    h.counts[std::min(static_cast<size_t>(latency / BIN_WIDTH), BINS)]++;
+    h.samples++;
+    h.dirty = true;
+}
+
+void AdaptiveTiming::miss(uint8_t address, uint8_t func) {
+    auto h = _find(address, func);
+    if (h != nullptr) {
+        *h = Histogram();
+    }
+}
+
+uint32_t AdaptiveTiming::timing(uint8_t address, uint8_t func, uint32_t ceiling) {
+    auto hp = _find(address, func);
+    if (hp == nullptr || hp->samples < _minSamples) {
+        return ceiling;
+    }
+
+    auto &h = *hp;
+    if (h.dirty) {
+        // smallest bin with at least 99.9% of samples at or below it
+        uint64_t required = (static_cast<uint64_t>(h.samples) * 999 + 999) / 1000;
+        uint64_t sum = 0;
+        size_t bin = 0;
+        for (; bin < BINS; bin++) {
+            sum += h.counts[bin];
+            if (sum >= required) {
+                break;
+            }
+        }
+        h.quantile = bin < BINS ? (bin + 1) * BIN_WIDTH : UINT32_MAX;
+        h.dirty = false;
+    }
+
+    if (h.quantile == UINT32_MAX) {
+        return ceiling;
+    }
+
+    return std::min(ceiling, h.quantile + _margin);
+}
+
+void AdaptiveTiming::clear() {
+    // ByteMap doesn't destroy erased values - release histograms, so they aren't reused
+    for (int func = 0; func < 256; func++) {
+        auto addresses = _histograms.find(func);
+        if (addresses != nullptr) {
+            addresses->reset();
+        }
+    }
+    _histograms.clear();
+}
+
+AdaptiveTiming::Histogram *AdaptiveTiming::_find(uint8_t address, uint8_t func) {
+    auto addresses = _histograms.find(func);
+    if (addresses == nullptr || *addresses == nullptr) {
+        return nullptr;
+    }
+    auto histogram = (*addresses)->find(address);
+    return histogram == nullptr ? nullptr : histogram->get();
+}
+
+void AdaptiveTiming::_copyHistograms(const AdaptiveTiming &other) {
+    for (int func = 0; func < 256; func++) {
+        auto addresses = other._histograms.find(func);
+        if (addresses == nullptr || *addresses == nullptr) {
+            continue;
+        }
+        auto &copy = _histograms[func];
+        copy = std::make_unique<AddressHistograms>();
+        for (int address = 0; address < 256; address++) {
+            auto histogram = (*addresses)->find(address);
+            if (histogram != nullptr && *histogram != nullptr) {
+                (*copy)[address] = std::make_unique<Histogram>(**histogram);
+            }
+        }
+    }
+}
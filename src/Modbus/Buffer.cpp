@@ -37,11 +37,20 @@ Buffer::Buffer() : std::vector<uint8_t>() {}
 Buffer::~Buffer() {}
 
 uint16_t Buffer::getCalcCrc() {
-    CRC crc(*this);
-    return crc.get();
+    if (_crcEnd == size() && _frameStart <= size()) {
+        return _crc.get();
+    }
+
+    // buffer was modified through std::vector methods
+    _frameStart = _currentFrameStart();
+    auto start = std::vector<uint8_t>::data() + _frameStart;
+    _crc = CRC(start, size() - _frameStart);
+    _crcEnd = size();
+    return _crc.get();
 }
 
 void Buffer::callFunction(uint8_t address, uint8_t func) {
+    _beginFrame();
     write(address);
     write(func);
     writeCRC();
@@ -57,4 +66,20 @@ void Buffer::writeCRC() {
     uint16_t crc = getCalcCrc();
     pushBuffer(crc & 0xFF);
     pushBuffer((crc >> 8) & 0xFF);
+    _lastFrameStart = _frameStart;
+    _beginFrame();
+}
+
+std::size_t Buffer::_currentFrameStart() {
+    // buffer could be shrinked through std::vector methods
+    if (_frameStart <= size()) {
+        return _frameStart;
+    }
+    return _lastFrameStart <= size() ? _lastFrameStart : 0;
+}
+
+void Buffer::_beginFrame() {
+    _frameStart = size();
+    _crc.reset();
+    _crcEnd = size();
 }
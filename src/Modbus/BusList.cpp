@@ -24,16 +24,30 @@
 
 using namespace Modbus;
 
-ErrorRecord::ErrorRecord() {
-    last_error_function = 0;
-    last_error_code = 0;
-    error_count = 0;
+uint64_t CommandRecord::_nextSerial() {
+    // 0 is reserved for no record
+    static std::atomic<uint64_t> next(1);
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+ErrorRecord::ErrorRecord() : last_error_function(0), last_error_code(0), error_count(0) {}
+
+ErrorRecord::ErrorRecord(const ErrorRecord &other)
+        : last_error_function(other.get_last_error_function()),
+          last_error_code(other.get_last_error_code()),
+          error_count(other.get_error_count()) {}
+
+ErrorRecord &ErrorRecord::operator=(const ErrorRecord &other) {
+    last_error_function.store(other.get_last_error_function(), std::memory_order_relaxed);
+    last_error_code.store(other.get_last_error_code(), std::memory_order_relaxed);
+    error_count.store(other.get_error_count(), std::memory_order_relaxed);
+    return *this;
 }
 
 void ErrorRecord::record(uint8_t func, uint8_t error) {
-    last_error_function = func;
-    last_error_code = error;
-    error_count++;
+    last_error_function.store(func, std::memory_order_relaxed);
+    last_error_code.store(error, std::memory_order_relaxed);
+    error_count.fetch_add(1, std::memory_order_relaxed);
 }
 
 ErrorResponse::ErrorResponse(uint8_t address, uint8_t func)
@@ -45,7 +59,7 @@ BusList::BusList() {}
 
 int BusList::responseLength(const std::vector<uint8_t> &response) { return -1; }
 
-void BusList::parse(Parser parser) {
+void BusList::parse(ParserView parser) {
     auto exp_address = at(_parsed_index).buffer.address();
     auto exp_func = at(_parsed_index).buffer.func();
 
@@ -53,35 +67,184 @@ void BusList::parse(Parser parser) {
     uint8_t called = parser.func();
 
     if (address != exp_address || (called & ~MODBUS_ERROR_MASK) != exp_func) {
+        _missed(at(_parsed_index).buffer);
         _parsed_index++;
         _errors[exp_address].record(called, 0xff);
 
         throw WrongResponse(address, exp_address, called, exp_func);
     }
 
-    if (called & MODBUS_ERROR_MASK) {
-        auto func = _functions.at(called & ~MODBUS_ERROR_MASK);
-        if (func.error_action != nullptr) {
-            func.error_action(address, called);
-            _parsed_index++;
-        } else {
-            _parsed_index++;
+    switch (_process(parser, address, called)) {
+        case ParseStatus::ERROR_RESPONSE:
             throw ErrorResponse(address, called);
+        case ParseStatus::UNEXPECTED_RESPONSE:
+            throw UnexpectedResponse(address, called);
+        default:
+            break;
+    }
+}
+
+ParseStatus BusList::tryParse(ParserView parser, size_t *skipped) {
+    if (skipped != nullptr) {
+        *skipped = 0;
+    }
+    _contiguous = false;
+
+    uint8_t address = parser.address();
+    uint8_t called = parser.func();
+    uint8_t func = called & ~MODBUS_ERROR_MASK;
+
+    if (_parsed_index >= size()) {
+        return ParseStatus::NO_COMMAND;
+    }
+
+    auto index = _parsed_index;
+    while (index < size() && (operator[](index).buffer.address() != address ||
+                              operator[](index).buffer.func() != func)) {
+        index++;
+    }
+
+    if (index >= size()) {
+        return ParseStatus::WRONG_RESPONSE;
+    }
+
+    _contiguous = index == _parsed_index;
+
+    for (; _parsed_index < index; _parsed_index++) {
+        auto &missing = operator[](_parsed_index).buffer;
+        if (isBroadcast(missing.address())) {
+            continue;
         }
-    } else {
-        _parsed_index++;
-        _functions.at(called).action(parser);
+        _errors[missing.address()].record(missing.func(), 0xff);
+        _missed(missing);
+        if (skipped != nullptr) {
+            (*skipped)++;
+        }
+    }
+
+    return _process(parser, address, called);
+}
+
+ParseStatus BusList::_process(ParserView &parser, uint8_t address, uint8_t called) {
+    _parsed_index++;
+
+    auto func = _functions.find(called & ~MODBUS_ERROR_MASK);
+    if (func == nullptr) {
+        return ParseStatus::UNEXPECTED_RESPONSE;
+    }
+
+    if (called & MODBUS_ERROR_MASK) {
+        if (_changeCache.tracked(called & ~MODBUS_ERROR_MASK)) {
+            _changeCache.invalidate(address, called & ~MODBUS_ERROR_MASK);
+        }
+        if (func->error_action == nullptr) {
+            return ParseStatus::ERROR_RESPONSE;
+        }
+        func->error_action(address, called);
+        return ParseStatus::ERROR_HANDLED;
     }
 
-    // throw UnexpectedResponse(address, called);
+    func->action(parser);
+
+    if (_changeCache.tracked(called)) {
+        _changeCache.acknowledge(at(_parsed_index - 1).buffer);
+    }
+
+    return ParseStatus::OK;
 }
 
-void BusList::add_response(uint8_t func, std::function<void(Parser)> action,
+void BusList::add_response(uint8_t func, std::function<void(ParserView &)> action,
                            std::function<void(uint8_t, uint8_t)> error_action) {
     _functions.emplace(func, ResponseRecord(action, error_action));
 }
 
-void BusList::missing_response() { _parsed_index++; };
+void BusList::_encodePending() {
+    // records were removed or replaced through std::vector methods (erase, vector's clear,..) - the last
+    // encoded record is gone or was moved, encode from the start
+    auto frames = _txEncoder.frames();
+    if (frames > size() || (frames > 0 && at(frames - 1).serial != _lastEncoded)) {
+        _txEncoder.reset();
+    }
+    for (auto i = _txEncoder.frames(); i < size(); i++) {
+        _txEncoder.add(at(i).buffer, at(i).timing);
+    }
+    _lastEncoded = empty() ? 0 : back().serial;
+}
+
+void BusList::freeze() {
+    _encodePending();
+    _patched.assign(size(), false);
+    _anyPatched = false;
+    _frozen = true;
+}
+
+void BusList::applyPatches() {
+    if (_anyPatched == false) {
+        return;
+    }
+    for (size_t i = 0; i < _patched.size(); i++) {
+        if (_patched[i]) {
+            auto &frame = at(i).buffer;
+            frame.updateCRC();
+            _txEncoder.patch(i, frame.size() - 2, frame.data() + frame.size() - 2, 2);
+            _patched[i] = false;
+        }
+    }
+    _anyPatched = false;
+}
+
+void BusList::_patch(size_t command, size_t offset, const uint8_t *data, size_t length) {
+    at(command).buffer.patch(offset, data, length);
+    _txEncoder.patch(command, offset, data, length);
+    _patched[command] = true;
+    _anyPatched = true;
+}
+
+void BusList::missing_response() {
+    if (_parsed_index < size()) {
+        _missed(at(_parsed_index).buffer);
+    }
+    _parsed_index++;
+};
+
+void BusList::setAdaptiveTiming(bool enabled) {
+    _adaptive = enabled;
+    if (_adaptive == false) {
+        // restore timing passed to callFunction
+        for (size_t i = 0; i < _txEncoder.frames(); i++) {
+            _txEncoder.setTiming(i, at(i).timing);
+        }
+    }
+}
+
+void BusList::endResponses() {
+    for (auto i = _parsed_index; i < size(); i++) {
+        _missed(at(i).buffer);
+    }
+}
+
+void BusList::_adaptTiming() {
+    for (size_t i = 0; i < _txEncoder.frames(); i++) {
+        auto &command = at(i);
+        if (isBroadcast(command.buffer.address())) {
+            continue;
+        }
+        _txEncoder.setTiming(i, _adaptiveTiming.timing(command.buffer.address(), command.buffer.func(),
+                                                       command.timing));
+    }
+}
+
+void BusList::_missed(const Frame &command) {
+    if (isBroadcast(command.address())) {
+        return;
+    }
+    if (_adaptive) {
+        _adaptiveTiming.miss(command.address(), command.func());
+    }
+    if (_changeCache.tracked(command.func())) {
+        _changeCache.invalidate(command.address(), command.func());
+    }
+}
 
 void BusList::set_error_response(uint8_t func, std::function<void(uint8_t, uint8_t)> error_action) {
     _functions.at(func).error_action = error_action;
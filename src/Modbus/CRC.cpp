@@ -24,14 +24,59 @@
 
 using namespace Modbus;
 
-void CRC::add(uint8_t data) {
-    _crcCounter = _crcCounter ^ (uint16_t(data));
-    for (int j = 0; j < 8; j++) {
-        if (_crcCounter & 0x0001) {
-            _crcCounter = _crcCounter >> 1;
-            _crcCounter = _crcCounter ^ 0xA001;
-        } else {
-            _crcCounter = _crcCounter >> 1;
+namespace {
+
+/**
+ * Generates lookup tables for the Modbus CRC (reflected 0xA001 polynomial).
+ * The first table holds the CRC of a single byte, the subsequent tables CRC of
+ * the byte followed by 1, 2,.. zero bytes.
+ *
+ * @return lookup tables for slice-by-N algorithm
+ */
+constexpr std::array<std::array<uint16_t, 256>, CRC::SLICES> generateTable() {
+    std::array<std::array<uint16_t, 256>, CRC::SLICES> table{};
+    for (uint16_t i = 0; i < 256; i++) {
+        uint16_t crc = i;
+        for (int j = 0; j < 8; j++) {
+            crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+        table[0][i] = crc;
+    }
+    for (std::size_t s = 1; s < CRC::SLICES; s++) {
+        for (uint16_t i = 0; i < 256; i++) {
+            table[s][i] = (table[s - 1][i] >> 8) ^ table[0][table[s - 1][i] & 0xFF];
+        }
+    }
+    return table;
+}
+
+}  // namespace
+
+const std::array<std::array<uint16_t, 256>, CRC::SLICES> CRC::_table = generateTable();
+
+void CRC::update(const uint8_t* data, std::size_t len) {
+    uint16_t crc = _crcCounter;
+
+    // slicing pays off only for longer buffers
+    if (len > 16) {
+        while (len >= 8) {
+            crc = _table[7][(data[0] ^ crc) & 0xFF] ^ _table[6][data[1] ^ (crc >> 8)] ^ _table[5][data[2]] ^
+                  _table[4][data[3]] ^ _table[3][data[4]] ^ _table[2][data[5]] ^ _table[1][data[6]] ^
+                  _table[0][data[7]];
+            data += 8;
+            len -= 8;
         }
+        if (len >= 4) {
+            crc = _table[3][(data[0] ^ crc) & 0xFF] ^ _table[2][data[1] ^ (crc >> 8)] ^ _table[1][data[2]] ^
+                  _table[0][data[3]];
+            data += 4;
+            len -= 4;
+        }
+    }
+
+    for (; len > 0; len--, data++) {
+        crc = (crc >> 8) ^ _table[0][(crc ^ *data) & 0xFF];
     }
+
+    _crcCounter = crc;
 }
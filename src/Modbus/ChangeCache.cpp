@@ -0,0 +1,101 @@
+/*
+ * Cache of the last acknowledged Modbus command arguments.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <Modbus/ChangeCache.h>
+
+using namespace Modbus;
+
+ChangeCache::ChangeCache(clock::duration refreshPeriod) : _refreshPeriod(refreshPeriod) {}
+
+void ChangeCache::track(uint8_t func, bool enabled, uint8_t keyBytes) {
+    if (keyBytes > 2) {
+        throw std::out_of_range(
+                fmt::format("Function {} key can have at most 2 bytes, {} requested", func, keyBytes));
+    }
+    if (enabled) {
+        _tracked.set(func, keyBytes);
+    } else {
+        _tracked.erase(func);
+        auto prefix = _prefix(0, func);
+        for (auto it = _values.begin(); it != _values.end();) {
+            if ((it->first & 0x00FF0000) == prefix) {
+                it = _values.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+}
+
+bool ChangeCache::unchanged(const Frame &command, clock::time_point now) {
+    if (_refreshPeriod == clock::duration::zero()) {
+        return false;
+    }
+
+    auto it = _values.find(_key(command));
+    if (it == _values.end() || now - it->second.acknowledged >= _refreshPeriod) {
+        return false;
+    }
+
+    auto &arguments = it->second.arguments;
+    // address, function and CRC aren't arguments
+    if (command.size() != arguments.size() + 4 ||
+        std::equal(arguments.begin(), arguments.end(), command.begin() + 2) == false) {
+        return false;
+    }
+
+    _suppressed++;
+    return true;
+}
+
+void ChangeCache::acknowledge(const Frame &command, clock::time_point now) {
+    if (command.size() < 4) {
+        return;
+    }
+    auto &value = _values[_key(command)];
+    value.arguments.assign(command.begin() + 2, command.end() - 2);
+    value.acknowledged = now;
+}
+
+void ChangeCache::invalidate(uint8_t address, uint8_t func) {
+    auto prefix = _prefix(address, func);
+    _values.erase(_values.lower_bound(prefix), _values.upper_bound(prefix | 0xFFFF));
+}
+
+void ChangeCache::invalidate(uint8_t address) {
+    uint32_t prefix = _prefix(address, 0);
+    _values.erase(_values.lower_bound(prefix), _values.upper_bound(prefix | 0xFFFFFF));
+}
+
+uint32_t ChangeCache::_key(const Frame &command) const {
+    uint32_t key = _prefix(command.address(), command.func());
+    auto keyBytes = _tracked.value(command.func());
+    for (uint8_t i = 0; i < keyBytes && i + 4u < command.size(); i++) {
+        key |= static_cast<uint32_t>(command.data()[2 + i]) << (8 * (1 - i));
+    }
+    return key;
+}
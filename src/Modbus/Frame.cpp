@@ -0,0 +1,66 @@
+/*
+ * Fixed capacity Modbus frame.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <Modbus/Frame.h>
+
+using namespace Modbus;
+
+void Frame::callFunction(uint8_t address, uint8_t func) {
+    write(address);
+    write(func);
+    writeCRC();
+}
+
+void Frame::writeI24(int32_t data) {
+    pushBuffer(data >> 16);
+    pushBuffer(data >> 8);
+    pushBuffer(data);
+}
+
+void Frame::writeCRC() {
+    uint16_t crc = _crc.get();
+    pushBuffer(crc & 0xFF);
+    pushBuffer((crc >> 8) & 0xFF);
+    _crc.reset();
+}
+
+void Frame::patch(std::size_t offset, const uint8_t* data, std::size_t length) {
+    if (offset + length > _length) {
+        throw std::out_of_range(fmt::format(
+                "Cannot patch Modbus frame beyond its end (patch end {}, frame length {}).", offset + length,
+                _length));
+    }
+    memcpy(_data.data() + offset, data, length);
+}
+
+void Frame::updateCRC() {
+    if (_length < 2) {
+        throw std::out_of_range("Cannot update CRC of frame shorter than 2 bytes.");
+    }
+    uint16_t crc = CRC(_data.data(), _length - 2).get();
+    _data[_length - 2] = crc & 0xFF;
+    _data[_length - 1] = (crc >> 8) & 0xFF;
+}
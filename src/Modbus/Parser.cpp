@@ -31,38 +31,47 @@ CRCError::CRCError(uint16_t calculated, uint16_t received)
         : std::runtime_error(fmt::format("checkCRC invalid CRC - expected 0x{:04x}, got 0x{:04x}.",
                                          calculated, received)) {}
 
-void Parser::parse(std::vector<uint8_t> buffer) {
-    if (buffer.size() < 4) {
+void ParserView::view(const uint8_t *data, size_t len) {
+    if (len < 4) {
         throw std::runtime_error(
                 fmt::format("Cannot parse small buffer (size {}) - minimal Modbus buffer length is 4 bytes "
                             "(address, function and "
                             "2 bytes CRC)",
-                            buffer.size()));
+                            len));
     }
-    assign(buffer.begin(), buffer.end());
+    _buffer = data;
+    _length = len;
     _data = 2;
 }
 
-void Parser::checkCRC() {
-    CRC crc(data(), _data);
+void ParserView::checkCRC() {
+    CRC crc(_buffer, _data);
     uint16_t calculated = crc.get();
     uint16_t received = be16toh(read<uint16_t>());
     if (calculated != received) {
         throw CRCError(calculated, received);
     }
-    if (_data < size()) {
-        throw LongResponse(data() + _data, size() - _data);
+    if (_data < _length) {
+        throw LongResponse(_buffer + _data, _length - _data);
     }
 }
 
-uint64_t Parser::readU48() {
+uint64_t ParserView::readU48() {
     uint64_t ret = 0;
     readBuffer(reinterpret_cast<uint8_t *>(&ret) + 2, 6);
     return be64toh(ret);
 }
 
-std::string Parser::readString(size_t length) {
-    uint8_t buf[length];
-    readBuffer(buf, length);
-    return std::string((const char *)buf, length);
+std::string ParserView::readString(size_t length) {
+    _checkLength(length);
+    std::string ret(reinterpret_cast<const char *>(_buffer + _data), length);
+    _data += length;
+    return ret;
+}
+
+void Parser::parse(const uint8_t *data, size_t len) {
+    // check length before the data are copied
+    view(data, len);
+    assign(data, data + len);
+    _rebind();
 }
@@ -0,0 +1,202 @@
+/*
+ * Decodes FPGA response FIFO words into Modbus frames.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <spdlog/fmt/fmt.h>
+
+#include <Modbus/RxDecoder.h>
+
+using namespace Modbus;
+using namespace LSST::cRIO;
+
+namespace {
+
+// SIMD step writes 8 bytes, even if fewer data words are found
+constexpr size_t STEP = 8;
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+/**
+ * Extracts bytes from 8 words, returns number of leading data words.
+ */
+inline size_t dataRun(const uint16_t *words, uint8_t *out) {
+#if defined(__SSE2__)
+    __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(words));
+    __m128i is_data = _mm_cmpeq_epi16(_mm_and_si128(w, _mm_set1_epi16(static_cast<int16_t>(FIFO::CMD_MASK))),
+                                      _mm_set1_epi16(static_cast<int16_t>(FIFO::RX_MASK & FIFO::CMD_MASK)));
+    uint32_t mask = _mm_movemask_epi8(is_data);
+    __m128i bytes = _mm_and_si128(_mm_srli_epi16(w, 1), _mm_set1_epi16(0x00FF));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(bytes, bytes));
+    // two mask bits per word
+    return mask == 0xFFFF ? STEP : __builtin_ctz(~mask) / 2;
+#else
+    uint16x8_t w = vld1q_u16(words);
+    uint16x8_t is_data =
+            vceqq_u16(vandq_u16(w, vdupq_n_u16(FIFO::CMD_MASK)), vdupq_n_u16(FIFO::RX_MASK & FIFO::CMD_MASK));
+    uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(is_data)), 0);
+    // narrowing keeps lower 8 bits
+    vst1_u8(out, vmovn_u16(vshrq_n_u16(w, 1)));
+    // 8 mask bits per word
+    return mask == UINT64_MAX ? STEP : __builtin_ctzll(~mask) / 8;
+#endif
+}
+#endif
+
+}  // namespace
+
+RxDecoder::RxDecoder(size_t capacity) : _arena(capacity + STEP) {
+    _frames.reserve(64);
+    reset();
+}
+
+void RxDecoder::reset() {
+    _arenaLength = 0;
+    _frames.clear();
+
+    _state = State::HEADER;
+    _headerShift = 0;
+    _streamTs = 0;
+    _beginTs = 0;
+    _endTs = 0;
+    _endTsShift = 0;
+}
+
+void RxDecoder::decode(const uint16_t *words, size_t length) {
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    _reserve(length);
+
+    const uint16_t *end = words + length;
+    while (words < end) {
+        if (_state != State::HEADER) {
+            while (end - words >= static_cast<ptrdiff_t>(STEP)) {
+                size_t run = dataRun(words, _arena.data() + _arenaLength);
+                if (run == 0) {
+                    break;
+                }
+                if (_state != State::DATA) {
+                    _openFrame();
+                }
+                _arenaLength += run;
+                words += run;
+                if (run < STEP) {
+                    break;
+                }
+            }
+            if (words == end) {
+                break;
+            }
+        }
+        _decodeWord(*words);
+        words++;
+    }
+#else
+    decodeScalar(words, length);
+#endif
+}
+
+void RxDecoder::decodeScalar(const uint16_t *words, size_t length) {
+    _reserve(length);
+
+    for (const uint16_t *end = words + length; words < end; words++) {
+        _decodeWord(*words);
+    }
+}
+
+void RxDecoder::finish() {
+    if (_state == State::DATA || _state == State::TRAILER) {
+        _closeFrame();
+    }
+}
+
+void RxDecoder::_reserve(size_t length) {
+    // each word adds at most one byte, SIMD step can write past the end
+    size_t required = _arenaLength + length + STEP;
+    if (_arena.size() < required) {
+        _arena.resize(std::max(required, _arena.size() * 2));
+    }
+}
+
+void RxDecoder::_openFrame() {
+    if (_state == State::TRAILER) {
+        _closeFrame();
+    }
+    _frames.push_back(RxFrame{_arenaLength, 0, _beginTs, 0});
+    _state = State::DATA;
+}
+
+void RxDecoder::_closeFrame() {
+    auto &frame = _frames.back();
+    frame.length = _arenaLength - frame.offset;
+    frame.end = _endTs;
+
+    _beginTs = _endTs;
+    _endTs = 0;
+    _endTsShift = 0;
+    _state = State::IDLE;
+}
+
+void RxDecoder::_decodeWord(uint16_t word) {
+    if (_state == State::HEADER) {
+        _streamTs |= static_cast<uint64_t>(word) << _headerShift;
+        _headerShift += 16;
+        if (_headerShift == 64) {
+            _beginTs = _streamTs;
+            _state = State::IDLE;
+        }
+        return;
+    }
+
+    switch (word & FIFO::CMD_MASK) {
+        case FIFO::RX_MASK & FIFO::CMD_MASK:
+            if (_state != State::DATA) {
+                _openFrame();
+            }
+            _arena[_arenaLength++] = static_cast<uint8_t>((word >> 1) & 0xFF);
+            break;
+        case FIFO::RX_ENDFRAME:
+            if (_state == State::DATA) {
+                _state = State::TRAILER;
+            }
+            break;
+        case FIFO::RX_TIMESTAMP:
+            // timestamp without received data (e.g. no ILC replied) - nothing to timestamp, ignore it
+            if (_state == State::IDLE) {
+                break;
+            }
+            if (_endTsShift == 64) {
+                throw std::runtime_error("End timestamp received twice!");
+            }
+            _endTs |= static_cast<uint64_t>(word & 0x00FF) << _endTsShift;
+            _endTsShift += 8;
+            _state = State::TRAILER;
+            break;
+        default:
+            throw std::runtime_error(fmt::format("Invalid reply: {0:04x} ({0})", word));
+    }
+}
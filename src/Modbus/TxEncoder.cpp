@@ -0,0 +1,66 @@
+/*
+ * Encodes Modbus frames into FPGA transmit FIFO words.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Modbus/TxEncoder.h>
+
+using namespace Modbus;
+using namespace LSST::cRIO;
+
+TxEncoder::TxEncoder() { reset(); }
+
+void TxEncoder::reset() {
+    _words.resize(HEADER_LENGTH);
+    _offsets.clear();
+    _sealed = false;
+}
+
+void TxEncoder::add(const Frame &frame, uint32_t timing) {
+    if (_sealed) {
+        _words.resize(_words.size() - TRAILER_LENGTH);
+        _sealed = false;
+    }
+
+    _offsets.push_back(_words.size());
+    for (auto b : frame) {
+        _words.push_back(FIFO::TX_MASK | (static_cast<uint16_t>(b) << 1));
+    }
+    _words.push_back(FIFO::TX_FRAMEEND);
+    _words.push_back(waitWord(timing));
+}
+
+const std::vector<uint16_t> &TxEncoder::seal(uint16_t txCommand, uint16_t trigger) {
+    if (_sealed) {
+        _words.resize(_words.size() - TRAILER_LENGTH);
+    }
+
+    _words[0] = txCommand;
+    _words[2] = FIFO::TX_WAIT_TRIGGER;
+    _words[3] = FIFO::TX_TIMESTAMP;
+
+    _words.push_back(FIFO::TX_IRQTRIGGER);
+    _words[1] = _words.size() - 2;
+    _words.push_back(trigger);
+
+    _sealed = true;
+
+    return _words;
+}
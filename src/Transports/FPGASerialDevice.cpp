@@ -112,12 +112,17 @@ void FPGASerialDevice::commands(Modbus::BusList& bus_list, std::chrono::microsec
                                 Thread* calling_thread) {
     auto end = std::chrono::steady_clock::now() + timeout;
 
-    for (auto cmd : bus_list) {
+    bus_list.applyPatches();
+
+    for (auto& cmd : bus_list) {
         execute_command(cmd.buffer, bus_list, end, calling_thread);
         std::this_thread::sleep_for(_quiet_time);
     }
 
-    bus_list.clear();
+    // frozen lists are send repeatedly
+    if (bus_list.frozen() == false) {
+        bus_list.clear();
+    }
 }
 
 void FPGASerialDevice::flush() {
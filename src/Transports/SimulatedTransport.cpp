@@ -53,11 +53,16 @@ void SimulatedTransport::commands(Modbus::BusList& bus_list, std::chrono::micros
                                   LSST::cRIO::Thread* calling_thread) {
     auto end = std::chrono::steady_clock::now() + timeout;
 
-    for (auto cmd : bus_list) {
+    bus_list.applyPatches();
+
+    for (auto& cmd : bus_list) {
         execute_command(cmd.buffer, bus_list, end, calling_thread);
     }
 
-    bus_list.clear();
+    // frozen lists are send repeatedly
+    if (bus_list.frozen() == false) {
+        bus_list.clear();
+    }
 }
 
 void SimulatedTransport::flush() {}
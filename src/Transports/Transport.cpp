@@ -24,7 +24,7 @@
 
 using namespace Transports;
 
-void Transport::execute_command(std::vector<uint8_t> command, Modbus::BusList& bus_list,
+void Transport::execute_command(const Modbus::Frame& command, Modbus::BusList& bus_list,
                                 std::chrono::time_point<std::chrono::steady_clock> end,
                                 LSST::cRIO::Thread* calling_thread) {
     auto now = std::chrono::steady_clock::now();
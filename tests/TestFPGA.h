@@ -81,6 +81,7 @@ private:
     double _currentTimestamp;
 
     std::atomic<uint32_t> _simulatedIRQs = 0;
+    uint32_t _modbusIRQ = 0;
 };
 
 #endif  //!__TEST_FPGA__
@@ -21,11 +21,15 @@
  */
 
 #include <atomic>
+#include <thread>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
 #include <cRIO/ControllerThread.h>
+#include <cRIO/IngressQueue.h>
 #include <cRIO/InterruptHandler.h>
+#include <cRIO/InterruptRing.h>
 #include <cRIO/Task.h>
 
 #include <TestFPGA.h>
@@ -264,6 +268,143 @@ TEST_CASE("Handling interrupts", "[ControllerThread]") {
     CHECK(iv == 6);
 
     ControllerThread::instance().stop();
+    ControllerThread::instance().stopInterruptWatcherTask();
 
     REQUIRE(iv == 6);
 }
+
+TEST_CASE("Ingress queue", "[ControllerThread]") {
+    IngressQueue<int> queue;
+
+    CHECK(queue.empty());
+
+    auto sequence = queue.signal.sequence();
+    for (int i = 0; i < 5; i++) {
+        queue.push(i);
+    }
+    CHECK_FALSE(queue.empty());
+    CHECK(queue.signal.sequence() == sequence + 5);
+
+    // returns immediately, as sequence changed
+    queue.signal.wait(sequence);
+
+    std::vector<int> drained;
+    CHECK(queue.drain([&drained](int&& v) { drained.push_back(v); }) == 5);
+    CHECK(drained == std::vector<int>({0, 1, 2, 3, 4}));
+    CHECK(queue.empty());
+
+    auto start = std::chrono::steady_clock::now();
+    queue.signal.wait_until(queue.signal.sequence(), start + 5ms);
+    CHECK(std::chrono::steady_clock::now() >= start + 5ms);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; p++) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < 1000; i++) {
+                queue.push(p * 1000 + i);
+            }
+        });
+    }
+
+    std::vector<int> last(4, -1);
+    size_t total = 0;
+    while (total < 4000) {
+        sequence = queue.signal.sequence();
+        total += queue.drain([&last](int&& v) {
+            // values of the same producer are kept in order
+            CHECK(v % 1000 == last[v / 1000] + 1);
+            last[v / 1000] = v % 1000;
+        });
+        if (total < 4000) {
+            queue.signal.wait_until(sequence, std::chrono::steady_clock::now() + 10ms);
+        }
+    }
+
+    for (auto& p : producers) {
+        p.join();
+    }
+
+    CHECK(last == std::vector<int>(4, 999));
+}
+
+TEST_CASE("Interrupt ring", "[ControllerThread]") {
+    InterruptRing ring;
+
+    CHECK(ring.empty());
+    CHECK(ring.drain() == 0);
+
+    CHECK(ring.push(0x01));
+    CHECK(ring.push(0x04));
+    CHECK_FALSE(ring.empty());
+
+    // burst is coalesced
+    CHECK(ring.drain() == 0x05);
+    CHECK(ring.empty());
+
+    for (size_t i = 0; i < InterruptRing::CAPACITY; i++) {
+        CHECK(ring.push(0x02));
+    }
+    // full ring doesn't lose interrupts
+    CHECK_FALSE(ring.push(0x10));
+    CHECK_FALSE(ring.push(0x20));
+
+    CHECK(ring.drain() == 0x32);
+    CHECK(ring.empty());
+
+    CHECK(ring.push(0x08));
+    CHECK(ring.drain() == 0x08);
+}
+
+TEST_CASE("Enqueue from multiple threads", "[ControllerThread]") {
+    tv = 0;
+
+    ControllerThread::instance().clear();
+    ControllerThread::instance().start();
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; p++) {
+        producers.emplace_back([]() {
+            for (int i = 0; i < 50; i++) {
+                ControllerThread::instance().enqueue_at(std::make_shared<NonRepeatTask>(),
+                                                        std::chrono::steady_clock::now());
+            }
+        });
+    }
+
+    for (auto& p : producers) {
+        p.join();
+    }
+
+    std::this_thread::sleep_for(20ms);
+
+    CHECK(tv == 200);
+
+    // allow some time for the thread to finish on loaded machines
+    ControllerThread::instance().stop(50ms);
+}
+
+TEST_CASE("Cancel and reschedule tasks", "[ControllerThread]") {
+    tv = 0;
+
+    ControllerThread::instance().clear();
+
+    auto now = std::chrono::steady_clock::now();
+    auto canceled = ControllerThread::instance().enqueue_at(std::make_shared<NonRepeatTask>(), now + 20ms);
+    auto later = ControllerThread::instance().enqueue_at(std::make_shared<NonRepeatTask>(), now + 500ms);
+    ControllerThread::instance().enqueue_at(std::make_shared<NonRepeatTask>(), now + 20ms);
+
+    CHECK(canceled != 0);
+    CHECK(ControllerThread::instance().cancel(canceled));
+    CHECK_FALSE(ControllerThread::instance().cancel(canceled));
+
+    ControllerThread::instance().start();
+
+    CHECK(ControllerThread::instance().reschedule(later, now + 30ms));
+
+    std::this_thread::sleep_for(60ms);
+
+    CHECK(tv == 2);
+    CHECK_FALSE(ControllerThread::instance().reschedule(later, now));
+
+    ControllerThread::instance().stop(50ms);
+}
@@ -0,0 +1,245 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests ILC cycle scheduler.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cRIO/ElectromechanicalPneumaticILC.h>
+#include <cRIO/PrintILC.h>
+#include <ILC/CycleScheduler.h>
+
+using namespace ILC;
+using namespace LSST::cRIO;
+
+// reportServerStatus and reportServerID frames
+const std::vector<CycleScheduler::FrameModel> STATUS = {{4, 270}};
+const std::vector<CycleScheduler::FrameModel> SERVER_ID = {{4, 835}};
+
+std::vector<uint8_t> addresses(ILCBusList &busList) {
+    std::vector<uint8_t> ret;
+    for (auto &c : busList) {
+        ret.push_back(c.buffer.address());
+    }
+    return ret;
+}
+
+TEST_CASE("Command time", "[CycleScheduler]") {
+    CycleScheduler scheduler(1000, 1000000);
+    PrintILC ilc(1);
+
+    ilc.reportServerStatus(1);
+    ilc.callFunction(2, 18, 5000);
+
+    // 4 bytes at 10 us per byte
+    CHECK(scheduler.commandTime(ilc[0]) == 40 + 270);
+    // long wait is encoded in milliseconds
+    CHECK(scheduler.commandTime(ilc[1]) == 40 + 6000);
+    CHECK(scheduler.commandTime(4, 5000) == 40 + 6000);
+
+    // periodic and background commands must declare their frames
+    CHECK_THROWS_AS(scheduler.add(Priority::PERIODIC, [](ILCBusList &bl) { bl.reportServerStatus(1); }),
+                    std::invalid_argument);
+    CHECK_NOTHROW(scheduler.add(Priority::CRITICAL, [](ILCBusList &bl) { bl.reportServerStatus(1); }));
+}
+
+TEST_CASE("Fill cycles", "[CycleScheduler]") {
+    CycleScheduler scheduler(1000, 1000000);
+    PrintILC ilc(1);
+
+    scheduler.add(Priority::BACKGROUND, [](ILCBusList &bl) { bl.reportServerID(5); }, SERVER_ID);
+    scheduler.add(Priority::CRITICAL, [](ILCBusList &bl) { bl.reportServerStatus(1); });
+    for (uint8_t address = 2; address < 5; address++) {
+        scheduler.add(
+                Priority::PERIODIC, [address](ILCBusList &bl) { bl.reportServerStatus(address); }, STATUS);
+    }
+
+    CHECK(scheduler.fill(ilc) == 930);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({1, 2, 3}));
+
+    // continues with the first command which didn't fit
+    CHECK(scheduler.fill(ilc) == 930);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({1, 4, 2}));
+
+    CHECK(scheduler.fill(ilc) == 930);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({1, 3, 4}));
+
+    // list can be parsed - commands which didn't fit weren't added
+    CHECK(ilc.size() == 3);
+    CHECK(ilc.encodeTx(24, 252).size() == 4 + 3 * (4 + 2) + 2);
+
+    scheduler.setBudget(2500);
+    CHECK(scheduler.fill(ilc) == 4 * 310 + 875);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({1, 2, 3, 4, 5}));
+
+    // critical commands are always sent
+    scheduler.setBudget(100);
+    CHECK(scheduler.fill(ilc) == 310);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({1}));
+
+    scheduler.clear();
+    CHECK(scheduler.fill(ilc) == 0);
+    CHECK(ilc.empty());
+}
+
+TEST_CASE("Commands which don't fit aren't run", "[CycleScheduler]") {
+    CycleScheduler scheduler(1000, 1000000);
+    PrintILC ilc(1);
+
+    int sent[3] = {0, 0, 0};
+    for (uint8_t address = 2; address < 5; address++) {
+        scheduler.add(
+                Priority::PERIODIC,
+                [&ilc, &sent, address](ILCBusList &bl) {
+                    if (&bl == &ilc) {
+                        sent[address - 2]++;
+                    }
+                    bl.reportServerStatus(address);
+                },
+                STATUS);
+    }
+
+    CHECK(scheduler.fill(ilc) == 3 * 310);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({2, 3, 4}));
+
+    scheduler.setBudget(700);
+    CHECK(scheduler.fill(ilc) == 2 * 310);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({2, 3}));
+    CHECK(sent[0] == 2);
+    CHECK(sent[1] == 2);
+    CHECK(sent[2] == 1);
+
+    CHECK(scheduler.fill(ilc) == 2 * 310);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({4, 2}));
+    CHECK(sent[1] == 2);
+    CHECK(sent[2] == 2);
+}
+
+TEST_CASE("Commands longer than budget", "[CycleScheduler]") {
+    CycleScheduler scheduler(700, 1000000);
+    PrintILC ilc(1);
+
+    scheduler.add(
+            Priority::PERIODIC,
+            [](ILCBusList &bl) {
+                bl.reportServerStatus(2);
+                bl.reportServerStatus(3);
+                bl.reportServerStatus(4);
+            },
+            {{4, 270}, {4, 270}, {4, 270}});
+    scheduler.add(Priority::PERIODIC, [](ILCBusList &bl) { bl.reportServerStatus(5); }, STATUS);
+    scheduler.add(Priority::PERIODIC, [](ILCBusList &bl) { bl.reportServerStatus(6); }, STATUS);
+    scheduler.add(Priority::PERIODIC, [](ILCBusList &bl) { bl.reportServerStatus(7); }, STATUS);
+
+    // the long command never fits, but doesn't block rotation of the other commands
+    CHECK(scheduler.fill(ilc) == 2 * 310);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({5, 6}));
+
+    CHECK(scheduler.fill(ilc) == 2 * 310);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({7, 5}));
+
+    scheduler.setBudget(1000);
+    CHECK(scheduler.fill(ilc) == 3 * 310);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({6, 7, 5}));
+}
+
+class TestEPILC : public ElectromechanicalPneumaticILC {
+public:
+    TestEPILC() : ILCBusList(1), ElectromechanicalPneumaticILC(1) {}
+
+protected:
+    void processServerID(uint8_t address, uint64_t uniqueID, uint8_t ilcAppType, uint8_t networkNodeType,
+                         uint8_t ilcSelectedOptions, uint8_t networkNodeOptions, uint8_t majorRev,
+                         uint8_t minorRev, std::string firmwareName) override {}
+    void processServerStatus(uint8_t address, uint8_t mode, uint16_t status, uint16_t faults) override {}
+    void processChangeILCMode(uint8_t address, uint16_t mode) override {}
+    void processSetTempILCAddress(uint8_t address, uint8_t newAddress) override {}
+    void processResetServer(uint8_t address) override {}
+    void processStepperForceStatus(uint8_t address, uint8_t status, int32_t encoderPosition,
+                                   float loadCellForce) override {}
+    void processDCAGain(uint8_t address, float primaryGain, float secondaryGain) override {}
+    void processHardpointLVDT(uint8_t address, float breakawayLVDT, float displacementLVDT) override {}
+    void processSAAForceStatus(uint8_t address, uint8_t status, float primaryLoadCellForce) override {}
+    void processDAAForceStatus(uint8_t address, uint8_t status, float primaryLoadCellForce,
+                               float secondaryLoadCellForce) override {}
+    void processCalibrationData(uint8_t address, float mainADCK[4], float mainOffset[4],
+                                float mainSensitivity[4], float backupADCK[4], float backupOffset[4],
+                                float backupSensitivity[4]) override {}
+    void processMezzaninePressure(uint8_t address, float primaryPush, float primaryPull, float secondaryPush,
+                                  float secondaryPull) override {}
+};
+
+TEST_CASE("Schedule ILC type specific commands", "[CycleScheduler]") {
+    CycleScheduler scheduler(2500, 1000000);
+    TestEPILC ilc;
+
+    scheduler.add(Priority::CRITICAL, [](ILCBusList &bl) { bl.reportServerStatus(1); });
+    // commands are run only on the filled bus list
+    scheduler.add(
+            Priority::BACKGROUND,
+            [](ILCBusList &bl) { dynamic_cast<ElectromechanicalPneumaticILC &>(bl).reportDCAGain(5); },
+            {{4, 2000}});
+
+    CHECK(scheduler.fill(ilc) == 310 + 2040);
+    REQUIRE(ilc.size() == 2);
+    CHECK(ilc[1].buffer.address() == 5);
+    CHECK(ilc[1].buffer.func() == ElectromechanicalPneumaticILC::ILC_EM_CMD::REPORT_DCA_GAIN);
+
+    scheduler.setBudget(2000);
+    CHECK(scheduler.fill(ilc) == 310);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({1}));
+}
+
+TEST_CASE("Schedule suppressed unchanged commands", "[CycleScheduler]") {
+    CycleScheduler scheduler(800, 1000000);
+    PrintILC ilc(1);
+    ilc.suppressUnchanged(ILCBusList::ILC_CMD::CHANGE_MODE);
+
+    uint16_t mode = Mode::Disabled;
+    // 6 bytes at 10 us per byte, 335 us timing
+    const std::vector<CycleScheduler::FrameModel> CHANGE_MODE = {{6, 335}};
+    for (uint8_t address = 2; address < 4; address++) {
+        scheduler.add(
+                Priority::PERIODIC, [&mode, address](ILCBusList &bl) { bl.changeILCMode(address, mode); },
+                CHANGE_MODE);
+    }
+    scheduler.add(Priority::PERIODIC, [](ILCBusList &bl) { bl.reportServerStatus(4); }, STATUS);
+
+    CHECK(scheduler.fill(ilc) == 2 * 395);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({2, 3}));
+
+    for (uint8_t address = 2; address < 4; address++) {
+        Modbus::Buffer reply(std::vector<uint8_t>({address, ILCBusList::ILC_CMD::CHANGE_MODE, 0, Mode::Disabled}));
+        reply.writeCRC();
+        CHECK(ilc.tryParse(reply) == Modbus::ParseStatus::OK);
+    }
+
+    // modes were acknowledged - change mode commands add no frames
+    CHECK(scheduler.fill(ilc) == 310);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({4}));
+
+    // commands which added no frames keep their size, so the changed commands don't overrun budget
+    mode = Mode::Enabled;
+    CHECK(scheduler.fill(ilc) == 310 + 395);
+    CHECK(addresses(ilc) == std::vector<uint8_t>({4, 2}));
+}
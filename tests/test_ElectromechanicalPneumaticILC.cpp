@@ -22,7 +22,9 @@
 
 #include <memory>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <new>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
@@ -32,6 +34,24 @@
 using namespace LSST::cRIO;
 using Catch::Approx;
 
+static bool count_allocations = false;
+static size_t allocations = 0;
+
+void *operator new(std::size_t size) {
+    if (count_allocations) {
+        allocations++;
+    }
+    void *ret = std::malloc(size);
+    if (ret == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ret;
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t size) noexcept { std::free(ptr); }
+
 class TestElectromechanicalPneumaticILC : public ElectromechanicalPneumaticILC {
 public:
     TestElectromechanicalPneumaticILC() : ILC::ILCBusList(1), ElectromechanicalPneumaticILC(1) {
@@ -142,6 +162,39 @@ TEST_CASE("Test SSA force set", "[ElectromechanicalPneumaticILC]") {
     REQUIRE(std::isnan(ilc.secondaryForce));
 }
 
+TEST_CASE("Coalesce stepper steps", "[ElectromechanicalPneumaticILC]") {
+    TestElectromechanicalPneumaticILC ilc;
+    auto steps = ElectromechanicalPneumaticILC::stepperStepsCoalescer({1, 2, 3, 4, 5, 6});
+
+    for (uint8_t address = 1; address <= 6; address++) {
+        steps.set(address, static_cast<int8_t>(address * 10));
+    }
+    CHECK(steps.flush(ilc));
+    REQUIRE(ilc.size() == 1);
+
+    Modbus::Parser parser(ilc[0].buffer);
+    CHECK(parser.address() == ElectromechanicalPneumaticILC::EA_BROADCAST);
+    CHECK(parser.func() == 66);
+    parser.read<uint8_t>();
+    for (int address = 1; address <= 6; address++) {
+        CHECK(static_cast<int8_t>(parser.read<uint8_t>()) == address * 10);
+    }
+    REQUIRE_NOTHROW(parser.checkCRC());
+
+    // three of six isn't majority - unicasts
+    ilc.clear();
+    for (uint8_t address = 1; address <= 3; address++) {
+        steps.set(address, static_cast<int8_t>(-5));
+    }
+    CHECK_FALSE(steps.flush(ilc));
+    REQUIRE(ilc.size() == 3);
+    Modbus::Parser unicast(ilc[2].buffer);
+    CHECK(unicast.address() == 3);
+    CHECK(unicast.func() == 66);
+    CHECK(static_cast<int8_t>(unicast.read<uint8_t>()) == -5);
+    REQUIRE_NOTHROW(unicast.checkCRC());
+}
+
 TEST_CASE("Test DAA force set", "[ElectromechanicalPneumaticILC]") {
     TestElectromechanicalPneumaticILC ilc;
 
@@ -311,3 +364,39 @@ TEST_CASE("Test parsing of pressure data", "[ElectromechanicalPneumaticILC]") {
 
     REQUIRE_NOTHROW(ilc.parse(response.data(), response.size()));
 }
+
+TEST_CASE("M1M3 command cycle doesn't allocate", "[ElectromechanicalPneumaticILC]") {
+    TestElectromechanicalPneumaticILC ilc;
+
+    auto cycle = [&ilc](uint8_t counter) {
+        ilc.clear();
+        ilc.freezeSensor(counter);
+        for (uint8_t address = 1; address <= 156; address++) {
+            if (address % 2) {
+                ilc.setSAAForceOffset(address, false, address * 1.5);
+            } else {
+                ilc.setDAAForceOffset(address, true, address * 1.5, -address * 2.25);
+            }
+            ilc.reportForceActuatorForceStatus(address);
+        }
+    };
+
+    // first cycle allocates bus list storage
+    cycle(1);
+
+    allocations = 0;
+    count_allocations = true;
+    cycle(2);
+    count_allocations = false;
+
+    CHECK(allocations == 0);
+    REQUIRE(ilc.size() == 1 + 2 * 156);
+
+    Modbus::Parser parser(ilc[3].buffer);
+    CHECK(parser.address() == 2);
+    CHECK(parser.func() == 75);
+    CHECK(parser.read<uint8_t>() == 0xFF);
+    CHECK(parser.read<Modbus::int24_t>().value == 3000);
+    CHECK(parser.read<Modbus::int24_t>().value == -4500);
+    CHECK_NOTHROW(parser.checkCRC());
+}
@@ -0,0 +1,291 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests FPGA ILC commands.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cRIO/FPGA.h>
+#include <cRIO/PrintILC.h>
+#include <cRIO/SimulatedILC.h>
+#include <ILC/DoubleBufferedBusList.h>
+
+using namespace LSST::cRIO;
+
+class TestILC : public PrintILC {
+public:
+    TestILC(uint8_t bus) : ILC::ILCBusList(bus), PrintILC(bus) {}
+
+    std::vector<std::pair<uint8_t, uint8_t>> statuses;
+
+protected:
+    void processServerStatus(uint8_t address, uint8_t mode, uint16_t status, uint16_t faults) override {
+        statuses.emplace_back(address, mode);
+    }
+};
+
+/**
+ * Simulates FPGA with multiple Modbus busses. Each bus replies to server
+ * status (function 18) with mode equal to bus number. IRQs are triggered one
+ * at time, starting with the highest bus.
+ */
+class MultiBusFPGA : public FPGA {
+public:
+    MultiBusFPGA() : FPGA(SS), _readBus(0), _pending(0) {}
+
+    void initialize() override {}
+    void open() override {}
+    void close() override {}
+    void finalize() override {}
+    uint16_t getTxCommand(uint8_t bus) override { return bus + 24; }
+    uint16_t getRxCommand(uint8_t bus) override { return bus + 14; }
+    uint32_t getIrq(uint8_t bus) override { return 1 << bus; }
+
+    void writeCommandFIFO(uint16_t* data, size_t length, uint32_t timeout) override;
+    void writeRequestFIFO(uint16_t* data, size_t length, uint32_t timeout) override {
+        _readBus = data[0] - 14;
+        events.push_back("R" + std::to_string(_readBus));
+    }
+    void readU16ResponseFIFO(uint16_t* data, size_t length, uint32_t timeout) override;
+    void waitOnIrqs(uint32_t irqs, uint32_t timeout, bool& timedout, uint32_t* triggered = NULL) override;
+    void ackIrqs(uint32_t irqs) override { _pending &= ~irqs; }
+
+    std::vector<std::string> events;
+    std::vector<uint32_t> waitedIrqs;
+
+protected:
+    std::map<uint8_t, SimulatedILC> _responses;
+    uint8_t _readBus;
+    uint32_t _pending;
+};
+
+void MultiBusFPGA::writeCommandFIFO(uint16_t* data, size_t length, uint32_t timeout) {
+    uint16_t* d = data;
+    while (d < data + length) {
+        // software trigger
+        if (*d == 252) {
+            d++;
+            continue;
+        }
+        uint8_t bus = *d - 24;
+        size_t len = d[1];
+        events.push_back("T" + std::to_string(bus));
+
+        auto& response = _responses[bus];
+        response.writeFPGATimestamp(0);
+
+        uint64_t timestamp = 0;
+        std::vector<uint8_t> frame;
+        for (uint16_t* w = d + 2; w < d + 2 + len; w++) {
+            if ((*w & FIFO::CMD_MASK) == FIFO::WRITE) {
+                frame.push_back((*w >> 1) & 0xFF);
+            } else if (*w == FIFO::TX_FRAMEEND) {
+                REQUIRE(frame[1] == 18);
+                response.write<uint8_t>(frame[0]);
+                response.write<uint8_t>(18);
+                response.write<uint8_t>(bus);
+                response.write<uint16_t>(0);
+                response.write<uint16_t>(0);
+                response.writeCRC();
+                response.writeRxTimestamp(++timestamp);
+                frame.clear();
+            }
+        }
+
+        _pending |= getIrq(bus);
+        d += len + 2;
+    }
+}
+
+void MultiBusFPGA::readU16ResponseFIFO(uint16_t* data, size_t length, uint32_t timeout) {
+    auto& response = _responses[_readBus];
+    if (length == 1) {
+        *data = response.getLength();
+    } else {
+        REQUIRE(length == response.getLength());
+        memcpy(data, response.getBuffer(), length * 2);
+        response.clear();
+    }
+}
+
+void MultiBusFPGA::waitOnIrqs(uint32_t irqs, uint32_t timeout, bool& timedout, uint32_t* triggered) {
+    waitedIrqs.push_back(irqs);
+    events.push_back("W");
+    timedout = false;
+    if (triggered == NULL) {
+        return;
+    }
+    uint32_t active = irqs & _pending;
+    for (uint32_t irq = 0x80000000; irq > 0; irq >>= 1) {
+        if (active & irq) {
+            *triggered = irq;
+            return;
+        }
+    }
+    *triggered = 0;
+}
+
+TEST_CASE("Parallel ILC commands", "[FPGA]") {
+    MultiBusFPGA fpga;
+
+    TestILC ilc1(1), ilc2(2), ilc3(3), empty(4);
+
+    ilc1.reportServerStatus(11);
+    ilc2.reportServerStatus(21);
+    ilc2.reportServerStatus(22);
+    ilc3.reportServerStatus(31);
+
+    REQUIRE_NOTHROW(fpga.ilcCommands({&ilc1, &empty, &ilc2, &ilc3}, 100));
+
+    CHECK(fpga.events == std::vector<std::string>({"T1", "T2", "T3", "W", "R3", "W", "R2", "W", "R1"}));
+    CHECK(fpga.waitedIrqs == std::vector<uint32_t>({0x0E, 0x06, 0x02}));
+
+    CHECK(ilc1.statuses == std::vector<std::pair<uint8_t, uint8_t>>({{11, 1}}));
+    CHECK(ilc2.statuses == std::vector<std::pair<uint8_t, uint8_t>>({{21, 2}, {22, 2}}));
+    CHECK(ilc3.statuses == std::vector<std::pair<uint8_t, uint8_t>>({{31, 3}}));
+    CHECK(empty.statuses.empty());
+
+    auto timing = fpga.timingRecorder().snapshot();
+    CHECK(timing.frames.size() == 4);
+    CHECK(timing.busses.size() == 3);
+    REQUIRE(timing.latencies.size() == 4);
+    CHECK(timing.latencies[1].bus == 2);
+    CHECK(timing.latencies[1].address == 21);
+
+    TestILC duplicate(2);
+    duplicate.reportServerStatus(23);
+
+    REQUIRE_THROWS_AS(fpga.ilcCommands({&ilc2, &duplicate}, 100), std::runtime_error);
+
+    fpga.events.clear();
+    REQUIRE_NOTHROW(fpga.ilcCommands({&empty}, 100));
+    CHECK(fpga.events.empty());
+}
+
+TEST_CASE("Pipelined ILC commands", "[FPGA]") {
+    MultiBusFPGA fpga;
+
+    ILC::DoubleBufferedBusList<TestILC> ilcs(2);
+
+    ilcs.front().reportServerStatus(21);
+
+    auto submission = fpga.ilcSubmit(ilcs.front());
+    CHECK(submission.pending());
+    CHECK(fpga.events == std::vector<std::string>({"T2"}));
+
+    CHECK_FALSE(fpga.ilcSubmit(ilcs.back()).pending());
+
+    ilcs.back().reportServerStatus(22);
+    REQUIRE_THROWS_AS(fpga.ilcSubmit(ilcs.back()), std::runtime_error);
+    REQUIRE_THROWS_AS(fpga.ilcCommands({&ilcs.back()}, 100), std::runtime_error);
+
+    REQUIRE_NOTHROW(fpga.ilcCollect(submission, 100));
+    CHECK_FALSE(submission.pending());
+    CHECK(fpga.events == std::vector<std::string>({"T2", "W", "R2"}));
+    CHECK(ilcs.front().statuses == std::vector<std::pair<uint8_t, uint8_t>>({{21, 2}}));
+
+    REQUIRE_NOTHROW(fpga.ilcCollect(submission, 100));
+
+    auto &first = ilcs.front();
+    ilcs.swap();
+    CHECK(&ilcs.back() == &first);
+    CHECK(first.empty());
+
+    submission = fpga.ilcSubmit(ilcs.front());
+    REQUIRE_NOTHROW(fpga.ilcCollect(submission, 100));
+    CHECK(ilcs.front().statuses == std::vector<std::pair<uint8_t, uint8_t>>({{22, 2}}));
+}
+
+class ThrowingILC : public TestILC {
+public:
+    ThrowingILC(uint8_t bus) : ILC::ILCBusList(bus), TestILC(bus) {}
+
+protected:
+    void processServerStatus(uint8_t address, uint8_t mode, uint16_t status, uint16_t faults) override {
+        throw std::runtime_error("Cannot process server status");
+    }
+};
+
+/**
+ * Provides response FIFO elements in place, at most chunk elements per
+ * acquire call.
+ */
+class ChunkedFPGA : public MultiBusFPGA {
+public:
+    ChunkedFPGA(size_t chunk) : MultiBusFPGA(), _chunk(chunk), _acquired(0), _offset(0) {}
+
+    const uint16_t* acquireU16ResponseFIFO(size_t length, uint32_t timeout, size_t& acquired) override {
+        REQUIRE(_acquired == 0);
+        auto& response = _responses[_readBus];
+        REQUIRE(_offset + length == response.getLength());
+        acquired = std::min(length, _chunk);
+        _acquired = acquired;
+        acquires++;
+        return response.getBuffer() + _offset;
+    }
+
+    void releaseU16ResponseFIFO(size_t elements) override {
+        REQUIRE(elements == _acquired);
+        _acquired = 0;
+        _offset += elements;
+        if (_offset == _responses[_readBus].getLength()) {
+            _responses[_readBus].clear();
+            _offset = 0;
+        }
+    }
+
+    size_t acquires = 0;
+
+private:
+    size_t _chunk;
+    size_t _acquired;
+    size_t _offset;
+};
+
+TEST_CASE("Acquire response FIFO elements", "[FPGA]") {
+    ChunkedFPGA fpga(3);
+
+    TestILC ilc(2);
+
+    ilc.reportServerStatus(21);
+    ilc.reportServerStatus(22);
+
+    REQUIRE_NOTHROW(fpga.ilcCommands(ilc, 100));
+    CHECK(ilc.statuses == std::vector<std::pair<uint8_t, uint8_t>>({{21, 2}, {22, 2}}));
+    CHECK(fpga.acquires > 10);
+
+    // exception thrown from callback shall not leave response elements in the FIFO
+    ThrowingILC throwing(2);
+    throwing.reportServerStatus(23);
+    throwing.reportServerStatus(24);
+    REQUIRE_THROWS_AS(fpga.ilcCommands(throwing, 100), std::runtime_error);
+
+    fpga.acquires = 0;
+    ilc.clear();
+    ilc.reportServerStatus(25);
+    REQUIRE_NOTHROW(fpga.ilcCommands(ilc, 100));
+    CHECK(ilc.statuses.back() == std::pair<uint8_t, uint8_t>(25, 2));
+    CHECK(fpga.acquires > 0);
+}
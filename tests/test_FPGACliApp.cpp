@@ -183,3 +183,67 @@ TEST_CASE("Tests multiple disable/enable", "[FPGACliApp]") {
     CHECK(testRuns == 4);
     CHECK(disabledCount == 0);
 }
+
+class SharedBusClass : public AClass {
+public:
+    SharedBusClass(const char* name, const char* description) : AClass(name, description) {
+        addILC(std::make_shared<PrintILC>(1));
+    }
+};
+
+TEST_CASE("ILCs sharing bus", "[FPGACliApp]") {
+    SharedBusClass cli("name", "description");
+
+    REQUIRE_NOTHROW(cli.processCmdVector({"open"}));
+
+    CHECK(cli.processCmdVector({"status", "0/8", "2/8"}) == 0);
+}
+
+class DispatchFPGA : public TestFPGA {
+public:
+    DispatchFPGA() : ILC::ILCBusList(1), TestFPGA() {}
+
+    using TestFPGA::ilcCommands;
+
+    void ilcCommands(std::vector<ILC::ILCBusList*> ilcs, int32_t timeout) override {
+        std::vector<uint8_t> buses;
+        for (auto ilc : ilcs) {
+            buses.push_back(ilc->getBus());
+            // TestFPGA simulates single bus
+            ilcCommands(*ilc, timeout);
+        }
+        rounds.push_back(buses);
+    }
+
+    std::vector<std::vector<uint8_t>> rounds;
+};
+
+class DispatchClass : public SharedBusClass {
+public:
+    DispatchClass(const char* name, const char* description) : SharedBusClass(name, description) {}
+
+    FPGA* newFPGA(const char* dir, bool& fpga_singleton) override {
+        fpga = new DispatchFPGA();
+        return fpga;
+    }
+
+    DispatchFPGA* fpga = nullptr;
+};
+
+TEST_CASE("ILCs on different busses dispatched together", "[FPGACliApp]") {
+    DispatchClass cli("name", "description");
+
+    REQUIRE_NOTHROW(cli.processCmdVector({"open"}));
+    REQUIRE(cli.fpga != nullptr);
+
+    CHECK(cli.processCmdVector({"status", "0/8", "1/8"}) == 0);
+    REQUIRE(cli.fpga->rounds.size() == 1);
+    CHECK(cli.fpga->rounds[0] == std::vector<uint8_t>({1, 4}));
+
+    cli.fpga->rounds.clear();
+
+    CHECK(cli.processCmdVector({"status", "0/8", "1/8", "2/8"}) == 0);
+    REQUIRE(cli.fpga->rounds.size() == 2);
+    CHECK(cli.fpga->rounds[0] == std::vector<uint8_t>({1, 4}));
+    CHECK(cli.fpga->rounds[1] == std::vector<uint8_t>({1}));
+}
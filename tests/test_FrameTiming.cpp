@@ -0,0 +1,99 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests FrameTimingRecorder.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sstream>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cRIO/FrameTiming.h>
+
+using namespace LSST::cRIO;
+using Catch::Approx;
+
+TEST_CASE("Frame timing statistics", "[FrameTiming]") {
+    FrameTimingRecorder recorder(4, 200);
+
+    // bus 1, cycle every 1000, ILC 5 replies in 1..200, ILC 6 in 100
+    for (uint64_t c = 0; c < 200; c++) {
+        uint64_t begin = c * 1000;
+        recorder.startCycle(1, begin);
+        recorder.record(1, 5, 18, begin, begin + c + 1);
+        recorder.record(1, 6, 18, begin + c + 1, begin + c + 101);
+    }
+
+    auto snapshot = recorder.snapshot();
+
+    REQUIRE(snapshot.frames.size() == 4);
+    CHECK(snapshot.frames[0].address == 5);
+    CHECK(snapshot.frames[0].begin == 198000);
+    CHECK(snapshot.frames[3].address == 6);
+    CHECK(snapshot.frames[3].end == 199000 + 300);
+    CHECK(snapshot.frames[3].duration() == 100);
+
+    REQUIRE(snapshot.latencies.size() == 2);
+    CHECK(snapshot.latencies[0].address == 5);
+    CHECK(snapshot.latencies[0].samples == 200);
+    CHECK(snapshot.latencies[0].min == 1);
+    CHECK(snapshot.latencies[0].mean == Approx(100.5));
+    CHECK(snapshot.latencies[0].p99 == 198);
+    CHECK(snapshot.latencies[0].max == 200);
+
+    CHECK(snapshot.latencies[1].address == 6);
+    CHECK(snapshot.latencies[1].min == 100);
+    CHECK(snapshot.latencies[1].max == 100);
+
+    REQUIRE(snapshot.busses.size() == 1);
+    CHECK(snapshot.busses[0].cycles == 200);
+    CHECK(snapshot.busses[0].period == 1000);
+    CHECK(snapshot.busses[0].busy == 299);
+    CHECK(snapshot.busses[0].last == Approx(0.299));
+    CHECK(snapshot.busses[0].max == Approx(0.299));
+
+    std::ostringstream os;
+    os << snapshot;
+    CHECK(os.str().find("29.90") != std::string::npos);
+
+    // frames following missing responses or broadcasts aren't included in latency statistics
+    recorder.record(1, 6, 18, 200000, 205000, false);
+    snapshot = recorder.snapshot();
+    CHECK(snapshot.frames.back().end == 205000);
+    CHECK(snapshot.latencies[1].samples == 200);
+    CHECK(snapshot.latencies[1].max == 100);
+
+    // frames closed without timestamp have unknown end
+    recorder.record(1, 6, 18, 205000, 0);
+    snapshot = recorder.snapshot();
+    CHECK(snapshot.frames.back().duration() == 0);
+    CHECK(snapshot.latencies[1].samples == 200);
+    CHECK(snapshot.latencies[1].max == 100);
+
+    recorder.setEnabled(false);
+    recorder.record(2, 5, 18, 0, 10);
+    CHECK(recorder.snapshot().busses.size() == 1);
+
+    recorder.clear();
+    snapshot = recorder.snapshot();
+    CHECK(snapshot.frames.empty());
+    CHECK(snapshot.latencies.empty());
+    CHECK(snapshot.busses.empty());
+}
@@ -130,6 +130,18 @@ TEST_CASE("Generic functions", "[ILC]") {
     CHECK_NOTHROW(parser.checkCRC());
 }
 
+TEST_CASE("Broadcast addresses", "[ILC]") {
+    TestILC ilc(1);
+
+    for (uint8_t address : {0, 148, 149, 248, 250, 255}) {
+        CHECK(ilc.isBroadcast(address) == true);
+    }
+
+    for (uint8_t address : {1, 147, 150, 247, 249, 251, 254}) {
+        CHECK(ilc.isBroadcast(address) == false);
+    }
+}
+
 TEST_CASE("Parse response", "[ILC]") {
     TestILC ilc(1);
 
@@ -541,3 +553,27 @@ TEST_CASE("Response cache management", "[ILC]") {
     CHECK(ilc.serverIDCallCounter == 8);
     CHECK(ilc.responseFirmwareName == "hbC");
 }
+
+TEST_CASE("Response length", "[ILC]") {
+    TestILC ilc(1);
+
+    CHECK(ilc.responseLength({}) == -1);
+    CHECK(ilc.responseLength({17}) == -1);
+
+    CHECK(ilc.responseLength({17, 17}) == -1);
+    CHECK(ilc.responseLength({17, 17, 15}) == 20);
+    CHECK(ilc.responseLength({17, 18}) == 9);
+    CHECK(ilc.responseLength({17, 65, 0x00}) == 6);
+    CHECK(ilc.responseLength({17, 72}) == 5);
+    CHECK(ilc.responseLength({17, 107}) == 4);
+
+    // error response
+    CHECK(ilc.responseLength({17, 0x80 | 65}) == 5);
+
+    // unknown function
+    CHECK(ilc.responseLength({17, 84}) == -1);
+    ilc.setResponseLength(17, 84, 16);
+    CHECK(ilc.responseLength({17, 84}) == 16);
+    CHECK(ilc.responseLength({18, 84}) == -1);
+    CHECK(ilc.responseLength({17, 0x80 | 84}) == 5);
+}
@@ -181,3 +181,87 @@ TEST_CASE("Call function with arguments (constructor)", "[Call]") {
     CHECK(mbuf[9] == 0xbb);
     CHECK(mbuf[10] == 0xad);
 }
+
+TEST_CASE("Multiple frames CRC", "[Write]") {
+    Buffer mbuf;
+    mbuf.callFunction(123, 17);
+    mbuf.callFunction(124, 18, uint16_t(0x1234));
+
+    REQUIRE(mbuf.size() == 10);
+
+    CHECK(mbuf[2] == 0xe3);
+    CHECK(mbuf[3] == 0x4c);
+
+    Buffer second(124, 18, uint16_t(0x1234));
+    REQUIRE(second.size() == 6);
+
+    for (size_t i = 0; i < second.size(); i++) {
+        CHECK(mbuf[i + 4] == second[i]);
+    }
+
+    // CRC of data appended directly through std::vector methods
+    Buffer pushed;
+    pushed.write<uint8_t>(123);
+    pushed.push_back(17);
+    pushed.writeCRC();
+
+    CHECK(pushed[2] == 0xe3);
+    CHECK(pushed[3] == 0x4c);
+
+    pushed.clear();
+    pushed.write<uint8_t>(123);
+    pushed.write<uint8_t>(17);
+    pushed.writeCRC();
+
+    REQUIRE(pushed.size() == 4);
+    CHECK(pushed[2] == 0xe3);
+    CHECK(pushed[3] == 0x4c);
+
+    // shrinked buffer restarts CRC from the last frame boundary
+    Buffer shrinked;
+    shrinked.callFunction(123, 17);
+    shrinked.callFunction(124, 18, uint16_t(0x1234));
+    shrinked.resize(7);
+    shrinked.writeCRC();
+
+    Buffer expected;
+    expected.callFunction(123, 17);
+    expected.write<uint8_t>(124);
+    expected.write<uint8_t>(18);
+    expected.write<uint8_t>(0x12);
+    expected.writeCRC();
+
+    CHECK(shrinked == expected);
+
+    // shrinked into the first frame
+    shrinked.resize(3);
+    shrinked.write<uint8_t>(0x4c);
+    shrinked.resize(2);
+    shrinked.writeCRC();
+
+    REQUIRE(shrinked.size() == 4);
+    CHECK(shrinked[2] == 0xe3);
+    CHECK(shrinked[3] == 0x4c);
+
+    // data modified in place
+    Buffer modified;
+    modified.write<uint8_t>(124);
+    modified.write<uint8_t>(17);
+    modified[1] = 18;
+    modified.write<uint16_t>(0x1234);
+    modified.writeCRC();
+
+    CHECK(modified == second);
+
+    // shrinked and regrown to the same size
+    Buffer regrown;
+    regrown.write<uint8_t>(124);
+    regrown.write<uint8_t>(17);
+    regrown.resize(1);
+    regrown.push_back(18);
+    regrown.write<uint16_t>(0x1234);
+    CHECK(regrown.getCalcCrc() == CRC(second.data(), 4).get());
+    regrown.writeCRC();
+
+    CHECK(regrown == second);
+}
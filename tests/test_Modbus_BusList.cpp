@@ -236,3 +236,350 @@ TEST_CASE("Response length calculations", "[ResponseLength]") {
     CHECK(buslist.responseLength({}) == -1);
     CHECK(buslist.responseLength({0x01, 0x02}) == -1);
 }
+
+TEST_CASE("Encode FPGA TX words", "[Encoding]") {
+    BusList buslist;
+
+    buslist.callFunction(0x11, 0x3, 200, static_cast<uint16_t>(0x1234));
+    buslist.callFunction(0x12, 0x4, 5000);
+
+    auto check_words = [&buslist](const std::vector<uint16_t> &words) {
+        std::vector<uint16_t> expected = {0xAB, 0, 0x8000, 0x3000};
+        for (auto &cmd : buslist) {
+            for (auto b : cmd.buffer) {
+                expected.push_back(0x1200 | (b << 1));
+            }
+            expected.push_back(0x20DA);
+            expected.push_back(cmd.timing > 0x0FFF ? (0x9000 | (cmd.timing / 1000 + 1))
+                                                   : (0x6000 | cmd.timing));
+        }
+        expected.push_back(0x7000);
+        expected[1] = expected.size() - 2;
+        expected.push_back(0xCD);
+
+        CHECK(words == expected);
+    };
+
+    check_words(buslist.encodeTx(0xAB, 0xCD));
+    CHECK(buslist.encodeTx(0xAB, 0xCD)[buslist[0].buffer.size() + 5] == 0x60C8);
+    CHECK(buslist.encodeTx(0xAB, 0xCD)[buslist[0].buffer.size() + buslist[1].buffer.size() + 7] == 0x9006);
+
+    buslist.callFunction(0x13, 0x5, 300, static_cast<uint8_t>(0xFE));
+    buslist.emplace_back(CommandRecord(buslist[0].buffer, 400));
+    check_words(buslist.encodeTx(0xAB, 0xCD));
+
+    buslist.clear();
+    buslist.callFunction(0x14, 0x6, 100);
+    check_words(buslist.encodeTx(0xAB, 0xCD));
+
+    // records removed behind BusList's back, list grows to the previous size
+    buslist.callFunction(0x15, 0x7, 100);
+    buslist.erase(buslist.begin() + 1);
+    buslist.callFunction(0x16, 0x8, 100);
+    check_words(buslist.encodeTx(0xAB, 0xCD));
+
+    std::vector<CommandRecord> &records = buslist;
+    records.clear();
+    buslist.callFunction(0x17, 0x9, 100);
+    check_words(buslist.encodeTx(0xAB, 0xCD));
+}
+
+TEST_CASE("Frozen bus list patching", "[Frozen]") {
+    auto build = [](BusList &buslist, uint16_t counter, float value, int24_t i24) {
+        buslist.callFunction(0, 75, 0, counter, value, i24);
+        buslist.callFunction(0x11, 0x3, 200, static_cast<uint16_t>(0x1234));
+        buslist.callFunction(0x12, 0x4, 5000, counter);
+    };
+
+    BusList frozen;
+    build(frozen, 1, 1.5, -300);
+
+    REQUIRE_THROWS_AS(frozen.slot<uint16_t>(0, 2), std::runtime_error);
+
+    frozen.freeze();
+    CHECK(frozen.frozen());
+
+    REQUIRE_THROWS_AS(frozen.callFunction(0x13, 0x5, 300), std::runtime_error);
+    REQUIRE_THROWS_AS(frozen.slot<uint16_t>(0, 1), std::out_of_range);
+    REQUIRE_THROWS_AS(frozen.slot<int24_t>(0, 9), std::out_of_range);
+
+    auto counter0 = frozen.slot<uint16_t>(0, 2);
+    auto value = frozen.slot<float>(0, 4);
+    auto i24 = frozen.slot<int24_t>(0, 8);
+    auto counter2 = frozen.slot<uint16_t>(2, 2);
+
+    frozen.encodeTx(0xAB, 0xCD);
+
+    for (uint16_t c = 2; c < 5; c++) {
+        frozen.patch(counter0, c);
+        frozen.patch(value, static_cast<float>(c * 2.25));
+        frozen.patch(i24, int24_t(-300 * c));
+        frozen.patch(counter2, c);
+
+        auto &words = frozen.encodeTx(0xAB, 0xCD);
+
+        BusList expected;
+        build(expected, c, c * 2.25, -300 * c);
+
+        REQUIRE(frozen.size() == expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            CHECK(std::vector<uint8_t>(frozen[i].buffer.begin(), frozen[i].buffer.end()) ==
+                  std::vector<uint8_t>(expected[i].buffer.begin(), expected[i].buffer.end()));
+        }
+        CHECK(words == expected.encodeTx(0xAB, 0xCD));
+    }
+
+    frozen.clear();
+    CHECK_FALSE(frozen.frozen());
+    CHECK_NOTHROW(frozen.callFunction(0x13, 0x5, 300));
+}
+
+TEST_CASE("Missing response without exceptions", "[BusListErrors]") {
+    TestList buslist(1);
+
+    auto generate_reply = [](uint8_t address) -> std::vector<uint8_t> {
+        Buffer mbuf(std::vector<uint8_t>({address, 0x03, 0x06, 0xAE, 0x41, 0x56, 0x52, 0x43, 0x40}));
+        mbuf.writeCRC();
+        return mbuf;
+    };
+
+    for (uint8_t address = 1; address < 10; address++) {
+        buslist.callFunction(address, 3, 200, static_cast<uint16_t>(0x1234), static_cast<uint16_t>(0x0003));
+        // broadcast - no reply expected
+        if (address == 4) {
+            buslist.callFunction(0, 3, 200, static_cast<uint16_t>(0x1234));
+        }
+    }
+
+    size_t skipped = 100;
+
+    buslist.expectedAddress = 1;
+    CHECK(buslist.tryParse(generate_reply(1), &skipped) == ParseStatus::OK);
+    CHECK(skipped == 0);
+    CHECK(buslist.lastParsedContiguous() == true);
+
+    // 2 is missing
+    buslist.expectedAddress = 3;
+    CHECK(buslist.tryParse(generate_reply(3), &skipped) == ParseStatus::OK);
+    CHECK(skipped == 1);
+    CHECK(buslist.lastParsedContiguous() == false);
+    CHECK(buslist.get_error_record(2).get_error_count() == 1);
+    CHECK(buslist.get_error_record(2).get_last_error_function() == 3);
+
+    // broadcast isn't counted as missing
+    buslist.expectedAddress = 5;
+    CHECK(buslist.tryParse(generate_reply(5), &skipped) == ParseStatus::OK);
+    CHECK(skipped == 1);
+    CHECK(buslist.get_error_record(4).get_error_count() == 1);
+    CHECK(buslist.get_error_record(0).get_error_count() == 0);
+
+    // reply from address not in list / already replied
+    CHECK(buslist.tryParse(generate_reply(12), &skipped) == ParseStatus::WRONG_RESPONSE);
+    CHECK(buslist.tryParse(generate_reply(3), &skipped) == ParseStatus::WRONG_RESPONSE);
+
+    buslist.expectedAddress = 9;
+    CHECK(buslist.tryParse(generate_reply(9), &skipped) == ParseStatus::OK);
+    CHECK(skipped == 3);
+    CHECK(buslist.tryParse(generate_reply(9), &skipped) == ParseStatus::NO_COMMAND);
+
+    // broadcast before reply isn't counted as missing, but the reply doesn't follow the previous reply
+    buslist.next_message();
+    buslist.clear();
+    buslist.callFunction(1, 3, 200, static_cast<uint16_t>(0x1234), static_cast<uint16_t>(0x0003));
+    buslist.callFunction(0, 3, 200, static_cast<uint16_t>(0x1234));
+    buslist.callFunction(2, 3, 200, static_cast<uint16_t>(0x1234), static_cast<uint16_t>(0x0003));
+
+    buslist.expectedAddress = 1;
+    CHECK(buslist.tryParse(generate_reply(1), &skipped) == ParseStatus::OK);
+    CHECK(buslist.lastParsedContiguous() == true);
+
+    buslist.expectedAddress = 2;
+    CHECK(buslist.tryParse(generate_reply(2), &skipped) == ParseStatus::OK);
+    CHECK(skipped == 0);
+    CHECK(buslist.lastParsedContiguous() == false);
+
+    // unknown function
+    buslist.next_message();
+    buslist.clear();
+    buslist.callFunction(1, 4, 200);
+    Buffer unknown(std::vector<uint8_t>({1, 4}));
+    unknown.writeCRC();
+    CHECK(buslist.tryParse(unknown) == ParseStatus::UNEXPECTED_RESPONSE);
+
+    buslist.next_message();
+    CHECK_THROWS_AS(buslist.parse(unknown), UnexpectedResponse);
+}
+
+TEST_CASE("Adaptive timing", "[AdaptiveTiming]") {
+    AdaptiveTiming timing(50, 10);
+
+    CHECK(timing.timing(1, 3, 1800) == 1800);
+
+    for (int i = 0; i < 999; i++) {
+        timing.record(1, 3, 300);
+    }
+    CHECK(timing.timing(1, 3, 1800) == 304 + 50);
+
+    // a single outlier in 1000 is above the 99.9th percentile
+    timing.record(1, 3, 1000);
+    CHECK(timing.timing(1, 3, 1800) == 304 + 50);
+    timing.record(1, 3, 1000);
+    CHECK(timing.timing(1, 3, 1800) == 1008 + 50);
+
+    // never exceeds ceiling
+    CHECK(timing.timing(1, 3, 500) == 500);
+    CHECK(timing.timing(1, 4, 500) == 500);
+
+    timing.miss(1, 3);
+    CHECK(timing.timing(1, 3, 1800) == 1800);
+
+    for (int i = 0; i < 10; i++) {
+        timing.record(2, 3, 300);
+    }
+    CHECK(timing.timing(2, 3, 1800) == 304 + 50);
+
+    // cleared history isn't reused
+    timing.clear();
+    CHECK(timing.timing(2, 3, 1800) == 1800);
+    timing.record(2, 3, 300);
+    CHECK(timing.timing(2, 3, 1800) == 1800);
+}
+
+TEST_CASE("Adaptive timing in encoded commands", "[AdaptiveTiming]") {
+    TestList buslist(1);
+
+    buslist.callFunction(0, 3, 200);
+    buslist.callFunction(1, 3, 1800, static_cast<uint16_t>(0x1234), static_cast<uint16_t>(0x0003));
+    buslist.callFunction(2, 3, 1800, static_cast<uint16_t>(0x1234), static_cast<uint16_t>(0x0003));
+    buslist.freeze();
+
+    size_t wait1 = 4 + buslist[0].buffer.size() + 2 + buslist[1].buffer.size() + 1;
+    size_t wait2 = wait1 + buslist[2].buffer.size() + 2;
+
+    // disabled - latencies are ignored
+    for (int i = 0; i < 200; i++) {
+        buslist.recordLatency(1, 3, 300);
+    }
+    CHECK(buslist.encodeTx(0xAB, 0xCD)[wait1] == (0x6000 | 1800));
+
+    buslist.setAdaptiveTiming(true);
+    for (int i = 0; i < 200; i++) {
+        buslist.recordLatency(0, 3, 10);
+        buslist.recordLatency(1, 3, 300);
+        buslist.recordLatency(2, 3, 400);
+    }
+    auto &words = buslist.encodeTx(0xAB, 0xCD);
+    CHECK(words[4 + buslist[0].buffer.size() + 1] == (0x6000 | 200));
+    CHECK(words[wait1] == (0x6000 | 354));
+    CHECK(words[wait2] == (0x6000 | 466));
+
+    Buffer reply(std::vector<uint8_t>({2, 0x03, 0x06, 0xAE, 0x41, 0x56, 0x52, 0x43, 0x40}));
+    reply.writeCRC();
+
+    // 1 is missing
+    buslist.expectedAddress = 2;
+    CHECK(buslist.tryParse(reply) == ParseStatus::OK);
+    buslist.endResponses();
+
+    CHECK(buslist.encodeTx(0xAB, 0xCD)[wait1] == (0x6000 | 1800));
+    CHECK(buslist.encodeTx(0xAB, 0xCD)[wait2] == (0x6000 | 466));
+
+    // 2 is missing
+    buslist.next_message();
+    buslist.endResponses();
+    CHECK(buslist.encodeTx(0xAB, 0xCD)[wait2] == (0x6000 | 1800));
+
+    for (int i = 0; i < 200; i++) {
+        buslist.recordLatency(2, 3, 400);
+    }
+    CHECK(buslist.encodeTx(0xAB, 0xCD)[wait2] == (0x6000 | 466));
+    buslist.setAdaptiveTiming(false);
+    CHECK(buslist.encodeTx(0xAB, 0xCD)[wait2] == (0x6000 | 1800));
+}
+
+TEST_CASE("Change cache", "[ChangeCache]") {
+    ChangeCache cache(std::chrono::seconds(10));
+    ChangeCache::clock::time_point now;
+
+    cache.track(6);
+    cache.track(7, true, 1);
+    CHECK(cache.tracked(6));
+    CHECK_FALSE(cache.tracked(3));
+    CHECK_THROWS_AS(cache.track(8, true, 3), std::out_of_range);
+
+    Frame set1(1, 6, static_cast<uint16_t>(0x1234));
+    Frame set2(1, 6, static_cast<uint16_t>(0x4321));
+
+    CHECK_FALSE(cache.unchanged(set1, now));
+    cache.acknowledge(set1, now);
+    CHECK(cache.unchanged(set1, now + std::chrono::seconds(9)));
+    CHECK_FALSE(cache.unchanged(set2, now));
+    CHECK_FALSE(cache.unchanged(Frame(2, 6, static_cast<uint16_t>(0x1234)), now));
+
+    // forced refresh
+    CHECK_FALSE(cache.unchanged(set1, now + std::chrono::seconds(10)));
+    CHECK(cache.suppressed() == 1);
+
+    // values are kept per channel
+    Frame channel1(1, 7, static_cast<uint8_t>(1), 1.5f);
+    Frame channel2(1, 7, static_cast<uint8_t>(2), 2.5f);
+    cache.acknowledge(channel1, now);
+    cache.acknowledge(channel2, now);
+    CHECK(cache.unchanged(channel1, now));
+    CHECK(cache.unchanged(channel2, now));
+    CHECK_FALSE(cache.unchanged(Frame(1, 7, static_cast<uint8_t>(2), 1.5f), now));
+
+    cache.invalidate(1, 6);
+    CHECK_FALSE(cache.unchanged(set1, now));
+    CHECK(cache.unchanged(channel1, now));
+
+    cache.invalidate(1);
+    CHECK_FALSE(cache.unchanged(channel1, now));
+    CHECK_FALSE(cache.unchanged(channel2, now));
+
+    cache.acknowledge(set1, now);
+    cache.setRefreshPeriod(ChangeCache::clock::duration::zero());
+    CHECK_FALSE(cache.unchanged(set1, now));
+}
+
+TEST_CASE("Suppress unchanged commands", "[ChangeCache]") {
+    BusList buslist;
+    buslist.add_response(6, [](ParserView &parser) {
+        parser.read<uint16_t>();
+        parser.checkCRC();
+    });
+    buslist.suppressUnchanged(6);
+
+    Buffer reply(std::vector<uint8_t>({1, 6, 0x12, 0x34}));
+    reply.writeCRC();
+
+    buslist.callFunction(1, 6, 300, static_cast<uint16_t>(0x1234));
+    buslist.callFunction(0, 6, 300, static_cast<uint16_t>(0x1234));
+    REQUIRE(buslist.size() == 2);
+    CHECK(buslist.tryParse(reply) == ParseStatus::OK);
+
+    // acknowledged - not added, broadcast is always send
+    buslist.clear();
+    buslist.callFunction(1, 6, 300, static_cast<uint16_t>(0x1234));
+    buslist.callFunction(0, 6, 300, static_cast<uint16_t>(0x1234));
+    CHECK(buslist.size() == 1);
+
+    buslist.callFunction(1, 6, 300, static_cast<uint16_t>(0x4321));
+    CHECK(buslist.size() == 2);
+
+    // missing reply forgets the value
+    buslist.clear();
+    buslist.next_message();
+    buslist.callFunction(1, 6, 300, static_cast<uint16_t>(0x1234));
+    CHECK(buslist.size() == 0);
+    buslist.callFunction(1, 6, 300, static_cast<uint16_t>(0x4321));
+    buslist.endResponses();
+
+    buslist.clear();
+    buslist.callFunction(1, 6, 300, static_cast<uint16_t>(0x1234));
+    CHECK(buslist.size() == 1);
+
+    buslist.suppressUnchanged(6, false);
+    buslist.callFunction(1, 6, 300, static_cast<uint16_t>(0x1234));
+    CHECK(buslist.size() == 2);
+}
@@ -0,0 +1,110 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests Modbus ByteMap class.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <functional>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <Modbus/ByteMap.h>
+
+using namespace Modbus;
+
+TEST_CASE("ByteMap presence", "[ByteMap]") {
+    ByteMap<int> map;
+
+    for (int k = 0; k < 256; k++) {
+        CHECK_FALSE(map.contains(k));
+        CHECK(map.find(k) == nullptr);
+        CHECK(map.value(k) == 0);
+    }
+
+    REQUIRE_THROWS_AS(map.at(10), std::out_of_range);
+
+    map.set(10, 5);
+    map[63] = 6;
+    map[64] = 7;
+    CHECK(map.emplace(255, 8));
+    CHECK_FALSE(map.emplace(255, 9));
+
+    for (int k = 0; k < 256; k++) {
+        bool present = k == 10 || k == 63 || k == 64 || k == 255;
+        CHECK(map.contains(k) == present);
+    }
+
+    CHECK(map.at(10) == 5);
+    CHECK(*map.find(63) == 6);
+    CHECK(map.at(64) == 7);
+    CHECK(map.at(255) == 8);
+
+    map.erase(63);
+    CHECK_FALSE(map.contains(63));
+    CHECK(map.contains(64));
+
+    map.clear();
+    CHECK_FALSE(map.contains(10));
+    CHECK_FALSE(map.contains(255));
+}
+
+TEST_CASE("ByteMap with atomic and function values", "[ByteMap]") {
+    ByteMap<std::atomic<uint8_t>> modes;
+    modes.set(3, 7);
+    CHECK(modes.at(3).load() == 7);
+    CHECK(modes.value(4).load() == 0);
+
+    ByteMap<std::function<int(int)>> actions;
+    actions.set(18, [](int a) { return a * 2; });
+    REQUIRE(actions.find(18) != nullptr);
+    CHECK((*actions.find(18))(21) == 42);
+    CHECK(actions.find(17) == nullptr);
+}
+
+TEST_CASE("ByteMap copy and move", "[ByteMap]") {
+    ByteMap<int> map;
+    map.set(10, 5);
+    map.set(200, 6);
+
+    ByteMap<int> copy(map);
+    CHECK(copy.at(10) == 5);
+    CHECK(copy.at(200) == 6);
+    CHECK_FALSE(copy.contains(11));
+
+    copy.erase(10);
+    CHECK(map.contains(10));
+
+    ByteMap<int> moved(std::move(copy));
+    CHECK_FALSE(moved.contains(10));
+    CHECK(moved.at(200) == 6);
+
+    moved = map;
+    CHECK(moved.at(10) == 5);
+
+    ByteMap<std::atomic<uint8_t>> modes;
+    modes.set(3, 7);
+
+    ByteMap<std::atomic<uint8_t>> modesCopy(modes);
+    CHECK(modesCopy.at(3).load() == 7);
+    CHECK_FALSE(modesCopy.contains(4));
+
+    modes.set(3, 8);
+    CHECK(modesCopy.at(3).load() == 7);
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests Modbus CRC class.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <Modbus/CRC.h>
+
+using namespace Modbus;
+
+/**
+ * Reference bit by bit CRC implementation.
+ */
+uint16_t bitCRC(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+TEST_CASE("Known CRC values", "[CRC]") {
+    CRC crc;
+
+    for (uint8_t d = 0; d < 0xFF; d++) {
+        crc.add(d);
+    }
+
+    CHECK(crc.get() == 0xADD6);
+
+    std::string str("Calculating CRC is as easy as answering 42.");
+    CRC crc_str(reinterpret_cast<const uint8_t *>(str.data()), str.length());
+
+    CHECK(crc_str.get() == 0x2879);
+
+    CRC crc_vec(std::vector<uint8_t>({0x12, 0x34, 0x56, 0x78, 0xff}));
+
+    CHECK(crc_vec.get() == 0x6310);
+}
+
+TEST_CASE("Sliced CRC matches bitwise calculation", "[CRC]") {
+    std::vector<uint8_t> data;
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < 1031; i++) {
+        seed = seed * 1103515245 + 12345;
+        data.push_back(seed >> 16);
+    }
+
+    for (size_t len = 0; len < data.size(); len++) {
+        CRC crc(data.data(), len);
+        REQUIRE(crc.get() == bitCRC(data.data(), len));
+    }
+}
+
+TEST_CASE("Incremental CRC update", "[CRC]") {
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < 517; i++) {
+        data.push_back(i * 7 + 3);
+    }
+
+    uint16_t expected = bitCRC(data.data(), data.size());
+
+    for (size_t chunk : {1, 3, 4, 8, 15, 17, 33, 256}) {
+        CRC crc;
+        for (size_t i = 0; i < data.size(); i += chunk) {
+            crc.update(data.data() + i, std::min(chunk, data.size() - i));
+        }
+        CHECK(crc.get() == expected);
+    }
+
+    CRC crc;
+    crc.update(data.data(), 100);
+    for (size_t i = 100; i < data.size(); i++) {
+        crc.add(data[i]);
+    }
+    CHECK(crc.get() == expected);
+}
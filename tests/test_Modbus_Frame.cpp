@@ -0,0 +1,93 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests Modbus frame class.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <Modbus/Buffer.h>
+#include <Modbus/Frame.h>
+#include <Modbus/Parser.h>
+
+using namespace Modbus;
+
+TEST_CASE("Frame CRC", "[Frame]") {
+    Frame frame;
+    frame.write<uint8_t>(123);
+    frame.write<uint8_t>(17);
+    frame.writeCRC();
+
+    REQUIRE(frame.size() == 4);
+
+    CHECK(frame[2] == 0xe3);
+    CHECK(frame[3] == 0x4c);
+
+    Frame func(123, 17);
+
+    REQUIRE(func.size() == 4);
+    CHECK(func.address() == 123);
+    CHECK(func.func() == 17);
+    CHECK(func[2] == 0xe3);
+    CHECK(func[3] == 0x4c);
+}
+
+TEST_CASE("Frame matches Buffer", "[Frame]") {
+    std::vector<uint16_t> values({0x1234, 0x5678, 0x9abc});
+    Buffer buffer(0x2b, 0x56, 0.123f, int8_t(-2), uint16_t(0x3456), int24_t(-1234), uint32_t(0x7890abcd),
+                  uint64_t(0xAAbbCCddEEff00), values);
+    Frame frame(0x2b, 0x56, 0.123f, int8_t(-2), uint16_t(0x3456), int24_t(-1234), uint32_t(0x7890abcd),
+                uint64_t(0xAAbbCCddEEff00), values);
+
+    REQUIRE(frame.size() == buffer.size());
+    CHECK(std::vector<uint8_t>(frame.begin(), frame.end()) == buffer);
+
+    Parser parser(frame);
+    CHECK(parser.address() == 0x2b);
+    CHECK(parser.func() == 0x56);
+    CHECK(parser.read<float>() == 0.123f);
+    CHECK(parser.read<uint8_t>() == 0xfe);
+    CHECK(parser.read<uint16_t>() == 0x3456);
+    CHECK(parser.read<int24_t>().value == -1234);
+    CHECK(parser.read<uint32_t>() == 0x7890abcd);
+    CHECK(parser.read<uint64_t>() == 0xAAbbCCddEEff00);
+    CHECK(parser.read<uint16_t>() == 0x1234);
+    CHECK(parser.read<uint16_t>() == 0x5678);
+    CHECK(parser.read<uint16_t>() == 0x9abc);
+    CHECK_NOTHROW(parser.checkCRC());
+}
+
+TEST_CASE("Frame overflow", "[Frame]") {
+    Frame frame;
+    for (size_t i = 0; i < Frame::MAX_LENGTH; i++) {
+        frame.write<uint8_t>(i);
+    }
+
+    CHECK(frame.size() == Frame::MAX_LENGTH);
+    CHECK_THROWS_AS(frame.write<uint8_t>(0), std::out_of_range);
+
+    frame.clear();
+    CHECK(frame.empty());
+
+    frame.callFunction(123, 17);
+    CHECK(frame.size() == 4);
+    CHECK(frame[3] == 0x4c);
+}
@@ -20,6 +20,9 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <type_traits>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include <Modbus/Parser.h>
@@ -46,6 +49,48 @@ TEST_CASE("Parser buffer", "[Parsing]") {
     REQUIRE_NOTHROW(parser.checkCRC());
 }
 
+TEST_CASE("Parser view", "[Parsing]") {
+    std::vector<uint8_t> data = {0x81, 0x11, 0x10, 0x12, 0x34, 0x56, 0x78, 0x90, 0xAA, 0xFF,
+                                 0xBB, 0xCC, 0xDD, 0xEE, 0x11, 0x53, 0x74, 0x61, 0x72, 0x12,
+                                 0x23, 0x34, 0xFF, 0xFF, 0xFF, 0x80, 0x00, 0x01, 0x84, 0x52};
+
+    ParserView view(data.data(), data.size());
+
+    CHECK(view.data() == data.data());
+    CHECK(view.size() == data.size());
+    CHECK(view.address() == 0x81);
+    CHECK(view.func() == 0x11);
+    CHECK(view.read<uint8_t>() == 0x10);
+    CHECK(view.read<uint16_t>() == 0x1234);
+
+    Parser copy(view);
+    CHECK(copy.data() != data.data());
+    CHECK(copy.read<uint32_t>() == 0x567890AA);
+
+    CHECK(view.read<uint32_t>() == 0x567890AA);
+    CHECK(view.read<uint64_t>() == 0xFFBBCCDDEE115374);
+    CHECK(view.readString(2) == "ar");
+    CHECK(view.read<int24_t>().value == 0x122334);
+    CHECK(view.read<int24_t>().value == -1);
+    CHECK(view.read<int24_t>().value == -0x7FFFFF);
+    REQUIRE_NOTHROW(view.checkCRC());
+
+    Parser parser(data);
+    Parser parser_copy(parser);
+    data[0] = 0x82;
+    CHECK(parser_copy.address() == 0x81);
+    CHECK(parser_copy.data() != parser.data());
+
+    // data can be changed only through parse, which rebinds the view
+    static_assert(std::is_convertible_v<Parser &, std::vector<uint8_t> &> == false);
+    parser_copy.parse(std::vector<uint8_t>({0x83, 0x12, 0x01, 0x02}));
+    CHECK(parser_copy.buffer() == std::vector<uint8_t>({0x83, 0x12, 0x01, 0x02}));
+    CHECK(parser_copy.address() == 0x83);
+    CHECK(parser_copy.read<uint16_t>() == 0x0102);
+
+    REQUIRE_THROWS_AS(view.view(data.data(), 3), std::runtime_error);
+}
+
 TEST_CASE("Small buffer", "[Parsing]") {
     std::vector<uint8_t> data = {0x81, 0x11, 0x10, 0x12, 0x34};
 
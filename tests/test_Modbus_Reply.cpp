@@ -0,0 +1,99 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests Modbus reply schemas.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <Modbus/Buffer.h>
+#include <Modbus/Reply.h>
+
+using namespace Modbus;
+
+TEST_CASE("Reply length", "[Reply]") {
+    CHECK(Reply<>::LENGTH == 4);
+    CHECK(Reply<uint8_t, int32_t, float>::LENGTH == 13);
+    CHECK(Reply<uint8_t, float, uint8_t, float>::DATA_LENGTH == 10);
+    CHECK(Reply<int24_t, uint64_t, int16_t>::LENGTH == 4 + 3 + 8 + 2);
+}
+
+TEST_CASE("Reply decoding", "[Reply]") {
+    typedef Reply<uint8_t, int32_t, float, int24_t, uint16_t> TestReply;
+
+    Buffer buf;
+    buf.write<uint8_t>(17);
+    buf.write<uint8_t>(67);
+    buf.write<uint8_t>(0xA5);
+    buf.write<int32_t>(-123456);
+    buf.write<float>(3.5);
+    buf.write(int24_t(-1234));
+    buf.write<uint16_t>(0xABCD);
+    buf.writeCRC();
+
+    REQUIRE(buf.size() == TestReply::LENGTH);
+
+    auto [status, encoder, force, offset, reg] = TestReply::parse(buf.data(), buf.size());
+    CHECK(status == 0xA5);
+    CHECK(encoder == -123456);
+    CHECK(force == 3.5);
+    CHECK(offset.value == -1234);
+    CHECK(reg == 0xABCD);
+
+    // decoding matches parser
+    ParserView parser(buf.data(), buf.size());
+    CHECK(parser.read<uint8_t>() == status);
+    CHECK(parser.read<int32_t>() == encoder);
+    CHECK(parser.read<float>() == force);
+    CHECK(parser.read<int24_t>().value == offset.value);
+    CHECK(parser.read<uint16_t>() == reg);
+    CHECK_NOTHROW(parser.checkCRC());
+
+    bool called = false;
+    auto action = TestReply::action(
+            [&called](uint8_t address, uint8_t status, int32_t encoder, float force, int24_t, uint16_t) {
+                CHECK(address == 17);
+                CHECK(status == 0xA5);
+                CHECK(encoder == -123456);
+                CHECK(force == 3.5);
+                called = true;
+            });
+    action(parser);
+    CHECK(called);
+}
+
+TEST_CASE("Reply validation", "[Reply]") {
+    typedef Reply<uint16_t, uint16_t> TestReply;
+
+    Buffer buf(std::vector<uint8_t>({0x11, 0x06, 0x00, 0x10, 0x12, 0x34}));
+    buf.writeCRC();
+
+    CHECK_NOTHROW(TestReply::check(buf.data(), buf.size()));
+    CHECK(std::get<1>(TestReply::parse(buf.data(), buf.size())) == 0x1234);
+
+    CHECK_THROWS_AS(TestReply::check(buf.data(), buf.size() - 1), std::out_of_range);
+    CHECK_THROWS_AS(Reply<uint16_t>::check(buf.data(), buf.size()), CRCError);
+
+    std::vector<uint8_t> longer(buf.begin(), buf.end());
+    longer.push_back(0x00);
+    CHECK_THROWS_AS(TestReply::check(longer.data(), longer.size()), LongResponse);
+
+    buf.data()[3] = 0x11;
+    CHECK_THROWS_AS(TestReply::parse(buf.data(), buf.size()), CRCError);
+}
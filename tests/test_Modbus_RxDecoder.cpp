@@ -0,0 +1,178 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests Modbus RxDecoder class.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cRIO/SimulatedILC.h>
+#include <Modbus/RxDecoder.h>
+
+using namespace Modbus;
+using namespace LSST::cRIO;
+
+TEST_CASE("Decode response stream", "[RxDecoder]") {
+    SimulatedILC response;
+
+    response.writeFPGATimestamp(0x0102030405060708);
+    response.write<uint8_t>(0x11);
+    response.write<uint8_t>(18);
+    response.write<uint16_t>(0x1234);
+    response.writeCRC();
+    response.writeRxTimestamp(0x1112131415161718);
+
+    std::vector<uint8_t> second;
+    for (int i = 0; i < 40; i++) {
+        second.push_back(i * 7);
+        response.write<uint8_t>(i * 7);
+    }
+    response.writeRxTimestamp(0x2122232425262728);
+
+    RxDecoder decoder(16);
+    decoder.decode(response.getBuffer(), response.getLength());
+    decoder.finish();
+
+    CHECK(decoder.beginTimestamp() == 0x0102030405060708);
+    REQUIRE(decoder.frames() == 2);
+
+    CHECK(decoder[0].length == 6);
+    CHECK(decoder[0].begin == 0x0102030405060708);
+    CHECK(decoder[0].end == 0x1112131415161718);
+    auto view = decoder.view(0);
+    CHECK(view.address() == 0x11);
+    CHECK(view.func() == 18);
+    CHECK(view.read<uint16_t>() == 0x1234);
+    CHECK_NOTHROW(view.checkCRC());
+
+    CHECK(decoder[1].begin == 0x1112131415161718);
+    CHECK(decoder[1].end == 0x2122232425262728);
+    CHECK(std::vector<uint8_t>(decoder.data(1), decoder.data(1) + decoder[1].length) == second);
+
+    decoder.reset();
+    CHECK(decoder.frames() == 0);
+
+    uint16_t invalid[] = {0, 0, 0, 0, 0x9002, 0x4000};
+    CHECK_THROWS_AS(decoder.decode(invalid, 6), std::runtime_error);
+
+    decoder.reset();
+    SimulatedILC stray;
+    stray.writeFPGATimestamp(0x0102030405060708);
+    stray.writeRxTimestamp(0x1112131415161718);
+    stray.write<uint8_t>(0x11);
+    stray.write<uint8_t>(18);
+    stray.writeCRC();
+    stray.writeRxTimestamp(0x2122232425262728);
+
+    REQUIRE_NOTHROW(decoder.decode(stray.getBuffer(), stray.getLength()));
+    decoder.finish();
+    REQUIRE(decoder.frames() == 1);
+    CHECK(decoder[0].length == 4);
+    CHECK(decoder[0].begin == 0x0102030405060708);
+    CHECK(decoder[0].end == 0x2122232425262728);
+}
+
+namespace {
+
+struct Result {
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<std::pair<uint64_t, uint64_t>> timestamps;
+    bool thrown = false;
+
+    bool operator==(const Result &other) const {
+        return frames == other.frames && timestamps == other.timestamps && thrown == other.thrown;
+    }
+};
+
+Result run(RxDecoder &decoder, const std::vector<uint16_t> &words, const std::vector<size_t> &chunks,
+           bool scalar) {
+    Result ret;
+    decoder.reset();
+    try {
+        const uint16_t *p = words.data();
+        for (auto c : chunks) {
+            if (scalar) {
+                decoder.decodeScalar(p, c);
+            } else {
+                decoder.decode(p, c);
+            }
+            p += c;
+        }
+        decoder.finish();
+    } catch (std::runtime_error &) {
+        ret.thrown = true;
+        return ret;
+    }
+    for (size_t i = 0; i < decoder.frames(); i++) {
+        ret.frames.emplace_back(decoder.data(i), decoder.data(i) + decoder[i].length);
+        ret.timestamps.emplace_back(decoder[i].begin, decoder[i].end);
+    }
+    return ret;
+}
+
+}  // namespace
+
+TEST_CASE("SIMD and scalar decoders equivalence", "[RxDecoder]") {
+    std::mt19937 gen(2024);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> pick(0, 99);
+
+    RxDecoder simd(8), scalar(8);
+
+    for (int iteration = 0; iteration < 2000; iteration++) {
+        std::vector<uint16_t> words;
+        for (int i = 0; i < 4; i++) {
+            words.push_back(byte(gen) | (byte(gen) << 8));
+        }
+
+        int frames = pick(gen) % 8;
+        for (int f = 0; f < frames; f++) {
+            int length = pick(gen) % 40;
+            for (int i = 0; i < length; i++) {
+                words.push_back(FIFO::RX_MASK | (byte(gen) << 1));
+            }
+            if (pick(gen) < 30) {
+                words.push_back(FIFO::RX_ENDFRAME);
+            }
+            int timestamps = pick(gen) < 80 ? 8 : pick(gen) % 10;
+            for (int i = 0; i < timestamps; i++) {
+                words.push_back(FIFO::RX_TIMESTAMP | byte(gen));
+            }
+            // occasional corrupted word
+            if (words.size() > 4 && pick(gen) < 3) {
+                words[4 + pick(gen) % (words.size() - 4)] ^= 0x1000 << (pick(gen) % 4);
+            }
+        }
+
+        std::vector<size_t> chunks;
+        for (size_t left = words.size(); left > 0;) {
+            size_t c = std::min(left, static_cast<size_t>(1 + pick(gen) % 20));
+            chunks.push_back(c);
+            left -= c;
+        }
+
+        auto expected = run(scalar, words, chunks, true);
+        CHECK(run(simd, words, chunks, false) == expected);
+        CHECK(run(simd, words, {words.size()}, false) == run(scalar, words, {words.size()}, true));
+    }
+}
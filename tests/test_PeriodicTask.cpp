@@ -0,0 +1,126 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests periodic tasks.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cRIO/ControllerThread.h>
+#include <cRIO/PeriodicTask.h>
+
+using namespace LSST::cRIO;
+using namespace std::chrono_literals;
+
+class CountingTask : public PeriodicTask {
+public:
+    CountingTask(std::chrono::microseconds period, MissedPolicy policy = MissedPolicy::SKIP, int limit = -1)
+            : PeriodicTask(period, policy), _limit(limit) {}
+
+    bool runPeriod() override {
+        count++;
+        return _limit < 0 || count < _limit;
+    }
+
+    std::atomic<int> count = 0;
+
+private:
+    int _limit;
+};
+
+TEST_CASE("Schedules against deadline", "[PeriodicTask]") {
+    CountingTask task(20000us);
+
+    auto deadline = std::chrono::steady_clock::now();
+
+    CHECK(task.run() == 0);
+    // execution time doesn't shift the next deadline
+    CHECK(task.nextRun(deadline, deadline + 5ms, 0) == deadline + 20ms);
+    CHECK(task.run() == 0);
+    CHECK(task.nextRun(deadline + 20ms, deadline + 39ms, 0) == deadline + 40ms);
+    CHECK(task.activations() == 2);
+    CHECK(task.skipped() == 0);
+
+    // sub-millisecond period
+    CountingTask fast(250us);
+    CHECK(fast.nextRun(deadline, deadline + 100us, 0) == deadline + 250us);
+}
+
+TEST_CASE("Missed periods", "[PeriodicTask]") {
+    auto deadline = std::chrono::steady_clock::now();
+
+    SECTION("Skip") {
+        CountingTask task(20ms, PeriodicTask::MissedPolicy::SKIP);
+        // finished past two deadlines - continue on the period grid
+        CHECK(task.nextRun(deadline, deadline + 45ms, 0) == deadline + 60ms);
+        CHECK(task.skipped() == 2);
+
+        // finished exactly on deadline - it's missed, as it cannot start on time
+        CHECK(task.nextRun(deadline + 60ms, deadline + 80ms, 0) == deadline + 100ms);
+        CHECK(task.skipped() == 3);
+    }
+
+    SECTION("Catch up") {
+        CountingTask task(20ms, PeriodicTask::MissedPolicy::CATCH_UP);
+        CHECK(task.nextRun(deadline, deadline + 45ms, 0) == deadline + 20ms);
+        CHECK(task.nextRun(deadline + 20ms, deadline + 46ms, 0) == deadline + 40ms);
+        CHECK(task.nextRun(deadline + 40ms, deadline + 47ms, 0) == deadline + 60ms);
+        CHECK(task.skipped() == 0);
+    }
+}
+
+TEST_CASE("Records lateness", "[PeriodicTask]") {
+    CountingTask task(10ms);
+
+    auto deadline = std::chrono::steady_clock::now() - 3ms;
+    task.run();
+    auto next = task.nextRun(deadline, std::chrono::steady_clock::now(), 0);
+
+    CHECK(next == deadline + 10ms);
+    CHECK(task.lastLateness() >= 3ms);
+    CHECK(task.maxLateness() == task.lastLateness());
+
+    task.resetStatistics();
+    CHECK(task.activations() == 0);
+    CHECK(task.maxLateness() == 0ns);
+
+    CHECK_THROWS_AS(CountingTask(0us), std::invalid_argument);
+}
+
+TEST_CASE("Run in ControllerThread", "[PeriodicTask]") {
+    auto task = std::make_shared<CountingTask>(2ms, PeriodicTask::MissedPolicy::SKIP, 5);
+
+    ControllerThread::instance().clear();
+    ControllerThread::instance().start();
+
+    CHECK(ControllerThread::instance().enqueue(task) != 0);
+
+    std::this_thread::sleep_for(50ms);
+
+    // runPeriod returned false on the fifth activation
+    CHECK(task->count == 5);
+    CHECK(task->activations() == 5);
+    CHECK(ControllerThread::instance().size() == 0);
+
+    ControllerThread::instance().stop(50ms);
+}
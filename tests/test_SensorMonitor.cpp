@@ -75,3 +75,19 @@ TEST_CASE("Process response of the SensorValue", "[SensorValues]") {
         CHECK(ilc.values[i] == i + 0.01f * i);
     }
 }
+
+TEST_CASE("Response length of the SensorValue", "[SensorValues]") {
+    TestSensorMonitor ilc;
+
+    CHECK(ilc.responseLength({83, 84}) == -1);
+    ilc.setSensorCount(83, 3);
+    CHECK(ilc.responseLength({83, 84}) == 16);
+    CHECK(ilc.responseLength({83, 18}) == 9);
+
+    // longest reply fitting into Modbus frame
+    ilc.setSensorCount(83, 63);
+    CHECK(ilc.responseLength({83, 84}) == 256);
+
+    CHECK_THROWS_AS(ilc.setSensorCount(83, 64), std::out_of_range);
+    CHECK(ilc.responseLength({83, 84}) == 256);
+}
@@ -0,0 +1,138 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests task queue.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cRIO/TaskQueue.h>
+
+using namespace LSST::cRIO;
+using namespace std::chrono_literals;
+
+class EmptyTask : public Task {
+public:
+    task_return_t run() override { return Task::DONT_RESCHEDULE; }
+};
+
+TEST_CASE("Ordered by time and insertion", "[TaskQueue]") {
+    TaskQueue queue;
+    auto now = std::chrono::steady_clock::now();
+    auto task = std::make_shared<EmptyTask>();
+
+    auto h3 = queue.push(TaskEntry(now + 3ms, task));
+    auto h1 = queue.push(TaskEntry(now + 1ms, task));
+    auto h2a = queue.push(TaskEntry(now + 2ms, task));
+    auto h2b = queue.push(TaskEntry(now + 2ms, task));
+
+    CHECK(h1 != h3);
+    CHECK(queue.size() == 4);
+    CHECK_THROWS_AS(queue.push(TaskEntry(now, task, h1)), std::runtime_error);
+
+    std::vector<task_handle_t> order;
+    while (queue.empty() == false) {
+        order.push_back(queue.top().handle);
+        queue.pop();
+    }
+    CHECK(order == std::vector<task_handle_t>({h1, h2a, h2b, h3}));
+}
+
+TEST_CASE("Cancel and reschedule", "[TaskQueue]") {
+    TaskQueue queue;
+    auto now = std::chrono::steady_clock::now();
+    auto task1 = std::make_shared<EmptyTask>();
+    auto task2 = std::make_shared<EmptyTask>();
+
+    auto h1 = queue.push(TaskEntry(now + 1ms, task1));
+    auto h2 = queue.push(TaskEntry(now + 2ms, task2));
+    auto h3 = queue.push(TaskEntry(now + 3ms, task1));
+
+    CHECK(queue.reschedule(h1, now + 4ms));
+    CHECK(queue.top().handle == h2);
+
+    CHECK(queue.cancel(h2));
+    CHECK_FALSE(queue.cancel(h2));
+    CHECK_FALSE(queue.contains(h2));
+    CHECK_FALSE(queue.reschedule(h2, now));
+    CHECK(queue.top().handle == h3);
+
+    CHECK(queue.remove(task1));
+    CHECK(queue.empty());
+    CHECK_FALSE(queue.remove(task1));
+
+    queue.push(TaskEntry(now, task2));
+    queue.clear();
+    CHECK(queue.empty());
+    CHECK(queue.size() == 0);
+}
+
+TEST_CASE("Random operations keep heap order", "[TaskQueue]") {
+    TaskQueue queue;
+    std::map<task_handle_t, std::chrono::steady_clock::time_point> expected;
+    auto now = std::chrono::steady_clock::now();
+    auto task = std::make_shared<EmptyTask>();
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> op(0, 3);
+    std::uniform_int_distribution<int> delay(0, 1000);
+
+    for (int i = 0; i < 5000; i++) {
+        switch (op(gen)) {
+            case 0:
+            case 1: {
+                auto when = now + std::chrono::microseconds(delay(gen));
+                expected[queue.push(TaskEntry(when, task))] = when;
+                break;
+            }
+            case 2:
+                if (expected.empty() == false) {
+                    auto it = std::next(expected.begin(), delay(gen) % expected.size());
+                    CHECK(queue.cancel(it->first));
+                    expected.erase(it);
+                }
+                break;
+            case 3:
+                if (expected.empty() == false) {
+                    auto it = std::next(expected.begin(), delay(gen) % expected.size());
+                    it->second = now + std::chrono::microseconds(delay(gen));
+                    CHECK(queue.reschedule(it->first, it->second));
+                }
+                break;
+        }
+        REQUIRE(queue.size() == expected.size());
+        if (expected.empty() == false) {
+            auto earliest = std::min_element(expected.begin(), expected.end(),
+                                             [](auto &a, auto &b) { return a.second < b.second; });
+            REQUIRE(queue.top().first == earliest->second);
+        }
+    }
+
+    auto last = std::chrono::steady_clock::time_point::min();
+    while (queue.empty() == false) {
+        REQUIRE(queue.top().first >= last);
+        last = queue.top().first;
+        queue.pop();
+    }
+}
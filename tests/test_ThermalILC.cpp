@@ -114,6 +114,96 @@ TEST_CASE("Broadcast set heater & fan target values", "[ThermalILC]") {
     REQUIRE_NOTHROW(parser.checkCRC());
 }
 
+TEST_CASE("Coalesce thermal demand", "[ThermalILC]") {
+    TestThermalILC ilc;
+    auto demand = ThermalILC::thermalDemandCoalescer(10);
+
+    // values of all ILCs aren't known - unicasts
+    demand.set(5, static_cast<uint8_t>(50), static_cast<uint8_t>(51));
+    demand.set(6, static_cast<uint8_t>(60), static_cast<uint8_t>(61));
+    CHECK(demand.pending() == 2);
+    CHECK_FALSE(demand.flush(ilc));
+    CHECK(demand.pending() == 0);
+    REQUIRE(ilc.size() == 2);
+    CHECK(ilc[0].buffer.address() == 5);
+    CHECK(ilc[1].buffer.address() == 6);
+    CHECK(ilc[1].timing == 500);
+
+    Modbus::Parser unicast(ilc[1].buffer);
+    CHECK(unicast.func() == 88);
+    CHECK(unicast.read<uint8_t>() == 60);
+    CHECK(unicast.read<uint8_t>() == 61);
+    REQUIRE_NOTHROW(unicast.checkCRC());
+
+    ilc.clear();
+    for (int address = 1; address <= NUM_TS_ILC; address++) {
+        demand.set(address, static_cast<uint8_t>(address), static_cast<uint8_t>(address + 1));
+    }
+    CHECK(demand.flush(ilc));
+    REQUIRE(ilc.size() == 1);
+
+    Modbus::Parser parser(ilc[0].buffer);
+    CHECK(parser.address() == 250);
+    CHECK(parser.func() == 88);
+    CHECK(parser.read<uint8_t>() == 1);
+    for (int address = 1; address <= NUM_TS_ILC; address++) {
+        CHECK(parser.read<uint8_t>() == address);
+        CHECK(parser.read<uint8_t>() == address + 1);
+    }
+    REQUIRE_NOTHROW(parser.checkCRC());
+
+    // below threshold - unicast
+    ilc.clear();
+    demand.set(7, static_cast<uint8_t>(70), static_cast<uint8_t>(71));
+    CHECK_FALSE(demand.flush(ilc));
+    REQUIRE(ilc.size() == 1);
+    CHECK(ilc[0].buffer.address() == 7);
+
+    // enough ILCs commanded, last known values used for the rest
+    ilc.clear();
+    for (int address = 11; address <= 20; address++) {
+        demand.set(address, static_cast<uint8_t>(0), static_cast<uint8_t>(0));
+    }
+    CHECK(demand.flush(ilc));
+    REQUIRE(ilc.size() == 1);
+    Modbus::Parser last(ilc[0].buffer);
+    last.read<uint8_t>();
+    for (int address = 1; address <= NUM_TS_ILC; address++) {
+        bool commanded = address >= 11 && address <= 20;
+        CHECK(last.read<uint8_t>() == (commanded ? 0 : (address == 7 ? 70 : address)));
+        CHECK(last.read<uint8_t>() == (commanded ? 0 : (address == 7 ? 71 : address + 1)));
+    }
+
+    CHECK_FALSE(demand.flush(ilc));
+    CHECK_THROWS_AS(demand.set(97, static_cast<uint8_t>(1), static_cast<uint8_t>(1)), std::out_of_range);
+    CHECK_THROWS_AS(demand.set(1, static_cast<uint8_t>(1)), std::runtime_error);
+}
+
+TEST_CASE("Thermal demand broadcast threshold", "[ThermalILC]") {
+    TestThermalILC ilc;
+    auto demand = ThermalILC::thermalDemandCoalescer();
+
+    for (int address = 1; address <= NUM_TS_ILC; address++) {
+        demand.set(address, static_cast<uint8_t>(1), static_cast<uint8_t>(2));
+    }
+    CHECK(demand.flush(ilc));
+
+    // minority of ILCs commanded - unicasts with status replies
+    ilc.clear();
+    for (int address = 1; address <= NUM_TS_ILC / 2; address++) {
+        demand.set(address, static_cast<uint8_t>(3), static_cast<uint8_t>(4));
+    }
+    CHECK_FALSE(demand.flush(ilc));
+    CHECK(ilc.size() == NUM_TS_ILC / 2);
+
+    ilc.clear();
+    for (int address = 1; address <= NUM_TS_ILC / 2 + 1; address++) {
+        demand.set(address, static_cast<uint8_t>(3), static_cast<uint8_t>(4));
+    }
+    CHECK(demand.flush(ilc));
+    CHECK(ilc.size() == 1);
+}
+
 TEST_CASE("Test parsing of thermal status response", "[ThermalILC]") {
     TestThermalILC ilc;
 
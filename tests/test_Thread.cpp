@@ -22,6 +22,9 @@
 
 #include <atomic>
 
+#include <pthread.h>
+#include <sched.h>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include <cRIO/Thread.h>
@@ -169,3 +172,76 @@ TEST_CASE("Test wait_until method", "[Thread]") {
 
     CHECK(thread.wait_until(end) == false);
 }
+
+class AttributesThread : public Thread {
+public:
+    size_t stackSize = 0;
+    int policy = -1;
+    bool cpu0 = false;
+    int cpuCount = 0;
+
+protected:
+    void run(std::unique_lock<std::mutex>& lock) override {
+        pthread_attr_t attr;
+        pthread_getattr_np(pthread_self(), &attr);
+        pthread_attr_getstacksize(&attr, &stackSize);
+        pthread_attr_destroy(&attr);
+
+        struct sched_param param;
+        pthread_getschedparam(pthread_self(), &policy, &param);
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+        cpu0 = CPU_ISSET(0, &set);
+        cpuCount = CPU_COUNT(&set);
+
+        while (keepRunning) {
+            runCondition.wait(lock);
+        }
+    }
+};
+
+TEST_CASE("Test thread attributes", "[Thread]") {
+    ThreadAttributes attributes;
+    CHECK(attributes.empty());
+
+    attributes.stackSize = 1024 * 1024;
+    attributes.stackPrefault = 128 * 1024;
+    attributes.cpus = {0};
+    // without real-time privileges only warning is logged
+    attributes.policy = SCHED_FIFO;
+    attributes.priority = 10;
+    CHECK_FALSE(attributes.empty());
+
+    AttributesThread thread;
+    thread.setAttributes(attributes);
+    CHECK(thread.getAttributes().stackSize == 1024 * 1024);
+
+    CHECK_NOTHROW(thread.start(100ms));
+    CHECK_NOTHROW(thread.stop(100ms));
+
+    CHECK(thread.stackSize >= 1024 * 1024);
+    CHECK(thread.cpu0);
+    CHECK(thread.cpuCount == 1);
+    CHECK((thread.policy == SCHED_FIFO || thread.policy == SCHED_OTHER));
+}
+
+TEST_CASE("Test thread attributes degrade", "[Thread]") {
+    ThreadAttributes attributes;
+    // invalid policy priority and prefault larger than stack
+    attributes.policy = SCHED_OTHER;
+    attributes.priority = 50;
+    attributes.stackSize = 256 * 1024;
+    attributes.stackPrefault = 1024 * 1024;
+    attributes.cpus = {CPU_SETSIZE + 1};
+
+    AttributesThread thread;
+    thread.setAttributes(attributes);
+
+    CHECK_NOTHROW(thread.start(100ms));
+    CHECK(thread.isRunning());
+    CHECK_NOTHROW(thread.stop(100ms));
+
+    CHECK(thread.policy == SCHED_OTHER);
+}
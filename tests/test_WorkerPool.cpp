@@ -0,0 +1,279 @@
+/*
+ * This file is part of LSST cRIOcpp test suite. Tests worker pool.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software Systems.
+ * This product includes software developed by the Vera C.Rubin Observatory Project
+ * (https://www.lsst.org). See the COPYRIGHT file at the top-level directory of
+ * this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cRIO/ControllerThread.h>
+#include <cRIO/WorkerPool.h>
+
+using namespace LSST::cRIO;
+using namespace std::chrono_literals;
+
+static std::atomic<bool> count_allocations = false;
+static std::atomic<size_t> allocations = 0;
+
+void *operator new(std::size_t size) {
+    if (count_allocations) {
+        allocations++;
+    }
+    void *ret = std::malloc(size);
+    if (ret == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ret;
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t size) noexcept { std::free(ptr); }
+
+TEST_CASE("Jobs with the same key are ordered", "[WorkerPool]") {
+    std::mutex mutex;
+    std::vector<std::vector<int>> runs(4);
+    std::atomic<int> running[4] = {0, 0, 0, 0};
+    std::atomic<bool> overlap = false;
+
+    {
+        WorkerPool pool(3);
+        CHECK(pool.workers() == 3);
+
+        for (int i = 0; i < 200; i++) {
+            task_key_t key = i % 4;
+            pool.submit(key, [&, key, i]() {
+                if (running[key]++ > 0) {
+                    overlap = true;
+                }
+                {
+                    std::lock_guard<std::mutex> lg(mutex);
+                    runs[key].push_back(i);
+                }
+                running[key]--;
+            });
+        }
+        // destructor finishes submitted jobs
+    }
+
+    CHECK_FALSE(overlap);
+    for (int key = 0; key < 4; key++) {
+        REQUIRE(runs[key].size() == 50);
+        for (int i = 0; i < 50; i++) {
+            CHECK(runs[key][i] == i * 4 + key);
+        }
+    }
+}
+
+TEST_CASE("Jobs with different keys run in parallel", "[WorkerPool]") {
+    std::atomic<int> running = 0;
+    std::atomic<int> finished = 0;
+
+    WorkerPool pool(2);
+
+    // both jobs must run together to finish - would block forever if serialized
+    for (task_key_t key = 1; key < 3; key++) {
+        pool.submit(key, [&]() {
+            running++;
+            auto end = std::chrono::steady_clock::now() + 2s;
+            while (running < 2 && std::chrono::steady_clock::now() < end) {
+                std::this_thread::yield();
+            }
+            finished++;
+        });
+    }
+
+    while (finished < 2) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    CHECK(running == 2);
+    CHECK(pool.pending() == 0);
+}
+
+TEST_CASE("Jobs submitted from jobs and exceptions", "[WorkerPool]") {
+    std::atomic<int> counter = 0;
+
+    {
+        WorkerPool pool(2);
+        pool.submit(1, []() { throw std::runtime_error("job failed"); });
+        pool.submit(1, [&]() {
+            for (int i = 0; i < 10; i++) {
+                pool.submit(i, [&]() { counter++; });
+            }
+        });
+    }
+
+    CHECK(counter == 10);
+
+    CHECK_THROWS_AS(WorkerPool(0), std::invalid_argument);
+}
+
+std::atomic<int> keyed_runs = 0;
+std::atomic<int> controller_running = 0;
+std::atomic<bool> controller_overlap = false;
+
+class KeyedTask : public Task {
+public:
+    KeyedTask(task_key_t key) : _key(key) {}
+
+    task_return_t run() override {
+        if (_key == CONTROLLER_KEY && controller_running++ > 0) {
+            controller_overlap = true;
+        }
+        std::this_thread::sleep_for(1ms);
+        keyed_runs++;
+        if (_key == CONTROLLER_KEY) {
+            controller_running--;
+        }
+        return Task::DONT_RESCHEDULE;
+    }
+
+    task_key_t serializationKey() const override { return _key; }
+
+private:
+    task_key_t _key;
+};
+
+TEST_CASE("ControllerThread with workers", "[WorkerPool]") {
+    auto& controller = ControllerThread::instance();
+
+    CHECK(controller.getWorkers() == 0);
+    controller.setWorkers(2);
+    CHECK(controller.getWorkers() == 2);
+
+    controller.start();
+
+    auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; i++) {
+        controller.enqueue_at(std::make_shared<KeyedTask>(i % 2 == 0 ? Task::CONTROLLER_KEY : i), now);
+    }
+
+    auto end = std::chrono::steady_clock::now() + 2s;
+    while (keyed_runs < 10 && std::chrono::steady_clock::now() < end) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    CHECK(keyed_runs == 10);
+    // tasks with the default key are still serialized
+    CHECK_FALSE(controller_overlap);
+    CHECK(controller.size() == 0);
+
+    controller.stop(50ms);
+    controller.setWorkers(0);
+    CHECK(controller.getWorkers() == 0);
+}
+
+std::atomic<int> handled = 0;
+
+class SerializedHandler : public InterruptHandler {
+public:
+    void handleInterrupt(uint8_t interrupt) override {
+        if (controller_running++ > 0) {
+            controller_overlap = true;
+        }
+        std::this_thread::sleep_for(1ms);
+        handled++;
+        controller_running--;
+    }
+};
+
+TEST_CASE("Interrupt handlers with workers", "[WorkerPool]") {
+    auto& controller = ControllerThread::instance();
+
+    keyed_runs = 0;
+    controller_running = 0;
+    controller_overlap = false;
+
+    controller.setInterruptHandler(std::make_shared<SerializedHandler>(), 32);
+    controller.setWorkers(2);
+    controller.start();
+
+    auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20; i++) {
+        controller.enqueue_at(std::make_shared<KeyedTask>(Task::CONTROLLER_KEY), now);
+    }
+
+    for (int i = 0; i < 10; i++) {
+        controller.signalInterrupts(0x80000000);
+        std::this_thread::sleep_for(2ms);
+    }
+
+    auto end = std::chrono::steady_clock::now() + 2s;
+    while ((keyed_runs < 20 || handled == 0) && std::chrono::steady_clock::now() < end) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    CHECK(keyed_runs == 20);
+    CHECK(handled > 0);
+    // handlers are serialized with tasks with the default key
+    CHECK_FALSE(controller_overlap);
+
+    controller.stop(50ms);
+    controller.setWorkers(0);
+}
+
+class CountingHandler : public InterruptHandler {
+public:
+    void handleInterrupt(uint8_t interrupt) override { counted++; }
+
+    std::atomic<int> counted = 0;
+};
+
+TEST_CASE("Interrupts with workers don't allocate", "[WorkerPool]") {
+    auto& controller = ControllerThread::instance();
+
+    auto handler = std::make_shared<CountingHandler>();
+    controller.setInterruptHandler(handler, 31);
+    controller.setWorkers(2);
+    controller.start();
+
+    auto wait_handled = [&handler](int count) {
+        auto end = std::chrono::steady_clock::now() + 2s;
+        while (handler->counted < count && std::chrono::steady_clock::now() < end) {
+            std::this_thread::yield();
+        }
+    };
+
+    controller.signalInterrupts(0x40000000);
+    wait_handled(1);
+    REQUIRE(handler->counted == 1);
+
+    allocations = 0;
+    count_allocations = true;
+    for (int i = 2; i <= 200; i++) {
+        controller.signalInterrupts(0x40000000);
+        wait_handled(i);
+    }
+    count_allocations = false;
+
+    CHECK(handler->counted == 200);
+    CHECK(allocations == 0);
+
+    controller.stop(50ms);
+    controller.setWorkers(0);
+}